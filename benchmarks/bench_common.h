@@ -0,0 +1,14 @@
+#ifndef MPS_BENCH_COMMON_H
+#define MPS_BENCH_COMMON_H
+
+#include <cstdlib>
+#include <string>
+
+// Directory of the MPS instances: $MPS_FILES_DIR if set, otherwise the repository's
+// mps_files (MPS_FILES_DIR_DEFAULT, defined for every benchmark in CMakeLists.txt)
+inline std::string mps_files_dir() {
+    const char* dir = std::getenv("MPS_FILES_DIR");
+    return dir ? dir : MPS_FILES_DIR_DEFAULT;
+}
+
+#endif // MPS_BENCH_COMMON_H
@@ -0,0 +1,238 @@
+#include <benchmark/benchmark.h>
+#include "bench_common.h"
+#include "mapped_file.h"
+#include "mps_generator.h"
+#include "mps_parser.h"
+#include "mps_tokenizer.h"
+#include "parquet_writer.h"
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Synthetic model with n_cols columns, n_cols / 2 rows and about 5 nonzeros per column
+void write_synthetic_mps(const std::string& path, int n_cols) {
+    mps::MpsGeneratorOptions options;
+    options.columns = n_cols;
+    options.rows = n_cols / 2;
+    options.density = 5.0 / options.rows;
+    options.integer_fraction = 0.5;
+    mps::generate_mps_file(path, options);
+}
+
+// Instance 0 is 50v-10.mps; instance s > 0 is a synthetic model with 10^(s+2) columns,
+// written to the temp directory on first use (removed again in main)
+std::map<int, std::string>& synthetic_paths() {
+    static std::map<int, std::string> paths;
+    return paths;
+}
+
+const std::string& instance_path(int instance) {
+    static const std::string mps_file = mps_files_dir() + "/50v-10.mps";
+    if (instance == 0) return mps_file;
+    auto& paths = synthetic_paths();
+    auto it = paths.find(instance);
+    if (it == paths.end()) {
+        int n_cols = 100;
+        for (int s = 0; s < instance; ++s) n_cols *= 10;
+        const std::string path = (fs::temp_directory_path() / ("bench_synthetic_" + std::to_string(n_cols) + ".mps")).string();
+        write_synthetic_mps(path, n_cols);
+        it = paths.emplace(instance, path).first;
+    }
+    return it->second;
+}
+
+std::string instance_label(int instance) {
+    return fs::path(instance_path(instance)).filename().string();
+}
+
+// Feeds the sections of an MPS text to the view parsers, stopping at COLUMNS if rows_only
+void load_state(std::string_view text, mps::ParserState& state, bool rows_only) {
+    mps::LineReader lines(text);
+    std::string_view line, section;
+    while (lines.next(line)) {
+        line = mps::trim_view(line);
+        if (line.empty() || line[0] == '*') continue;
+        if (line == "ENDATA") break;
+        // NAME is a header only before the first section, as in the parser
+        if (line == "ROWS" || line == "COLUMNS" || line == "RHS" || line == "RANGES" || line == "BOUNDS" ||
+            (section.empty() && mps::is_name_line(line))) {
+            section = line;
+            if (rows_only && section == "COLUMNS") break;
+            continue;
+        }
+        if (section == "ROWS") mps::parse_rows_view(line, state);
+        else if (section == "COLUMNS") mps::parse_columns_view(line, state);
+        else if (section == "RHS") mps::parse_rhs_view(line, state);
+        else if (section == "BOUNDS") mps::parse_bounds_view(line, state);
+    }
+}
+
+// Byte range of the COLUMNS body, for the section throughput benchmark
+std::string_view columns_body(std::string_view text) {
+    const size_t header = text.find("\nCOLUMNS");
+    const size_t begin = text.find('\n', header + 1) + 1;
+    const size_t end = text.find("\nRHS", begin);
+    return text.substr(begin, end == std::string_view::npos ? std::string_view::npos : end + 1 - begin);
+}
+
+void set_nnz_rate(benchmark::State& state, size_t nonzeros) {
+    state.counters["nnz/s"] = benchmark::Counter(static_cast<double>(nonzeros) * state.iterations(),
+                                                 benchmark::Counter::kIsRate);
+}
+
+size_t model_nonzeros(const mps::LpData& lp) {
+    return lp.get_A_eq().nonZeros() + lp.get_A_ineq().nonZeros();
+}
+
+// Model of each instance, parsed once for the nonzero counts and the writer benchmarks
+const mps::LpData& parsed_instance(int instance) {
+    static std::map<int, std::unique_ptr<mps::LpData>> models;
+    auto& lp = models[instance];
+    if (!lp) lp = mps::parse_mps(instance_path(instance));
+    return *lp;
+}
+
+// Line splitting and field tokenizing of the whole file, no parsing
+void BM_Tokenize(benchmark::State& state) {
+    mps::MappedFile file(instance_path(state.range(0)));
+    size_t fields = 0;
+    for (auto _ : state) {
+        mps::LineReader lines(file.view());
+        std::string_view line, token;
+        fields = 0;
+        while (lines.next(line)) {
+            mps::TokenCursor tokens(mps::trim_view(line));
+            while (tokens.next(token)) ++fields;
+        }
+        benchmark::DoNotOptimize(fields);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(file.view().size()) * state.iterations());
+    state.counters["fields"] = static_cast<double>(fields);
+    state.SetLabel(instance_label(state.range(0)));
+}
+
+// COLUMNS body into a state with ROWS already loaded; arg 1 selects
+// parse_columns_view (0) or the istringstream-based parse_columns_section (1)
+void BM_ParseColumnsSection(benchmark::State& state) {
+    mps::MappedFile file(instance_path(state.range(0)));
+    const std::string_view body = columns_body(file.view());
+    const bool use_views = state.range(1) == 0;
+    std::string line_copy;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto parser_state = std::make_unique<mps::ParserState>();
+        load_state(file.view(), *parser_state, true);
+        state.ResumeTiming();
+
+        mps::LineReader lines(body);
+        std::string_view line;
+        while (lines.next(line)) {
+            line = mps::trim_view(line);
+            if (line.empty() || line[0] == '*') continue;
+            if (use_views) {
+                mps::parse_columns_view(line, *parser_state);
+            } else {
+                line_copy.assign(line);
+                mps::parse_columns_section(line_copy, *parser_state);
+            }
+        }
+
+        state.PauseTiming();
+        parser_state.reset();
+        state.ResumeTiming();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(body.size()) * state.iterations());
+    set_nnz_rate(state, model_nonzeros(parsed_instance(state.range(0))));
+    state.SetLabel(instance_label(state.range(0)) + (use_views ? " views" : " istringstream"));
+}
+
+// Splitting the parsed coefficients into A_eq / A_ineq; arg 1 selects the assembly mode
+void BM_BuildMatrices(benchmark::State& state) {
+    mps::MappedFile file(instance_path(state.range(0)));
+    mps::ParserState parser_state;
+    load_state(file.view(), parser_state, false);
+    const auto assembly = state.range(1) == 0 ? mps::MatrixAssembly::Triplets : mps::MatrixAssembly::Direct;
+
+    size_t nonzeros = 0;
+    for (auto _ : state) {
+        int n_vars = 0;
+        Eigen::VectorXd c, b_eq, b_ineq;
+        Eigen::SparseMatrix<double> A_eq, A_ineq;
+        parser_state.build_matrices(n_vars, c, A_eq, b_eq, A_ineq, b_ineq, assembly);
+        nonzeros = A_eq.nonZeros() + A_ineq.nonZeros();
+        benchmark::DoNotOptimize(A_ineq.valuePtr());
+    }
+    set_nnz_rate(state, nonzeros);
+    state.SetLabel(instance_label(state.range(0)) + (state.range(1) == 0 ? " triplets" : " direct"));
+}
+
+void BM_SaveCooMatrix(benchmark::State& state) {
+    const auto& matrix = parsed_instance(state.range(0)).get_A_ineq();
+    const std::string filename = (fs::temp_directory_path() / "bench_hot_paths_coo.parquet").string();
+    for (auto _ : state) {
+        auto status = mps::save_coo_matrix(matrix, filename);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(fs::file_size(filename)) * state.iterations());
+    set_nnz_rate(state, matrix.nonZeros());
+    state.SetLabel(instance_label(state.range(0)));
+    fs::remove(filename);
+}
+
+void BM_SaveVector(benchmark::State& state) {
+    const auto& c = parsed_instance(state.range(0)).get_c();
+    const std::string filename = (fs::temp_directory_path() / "bench_hot_paths_vector.parquet").string();
+    for (auto _ : state) {
+        auto status = mps::save_vector(c, "c", filename);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(c.size() * sizeof(double)) * state.iterations());
+    state.SetItemsProcessed(c.size() * state.iterations());
+    state.SetLabel(instance_label(state.range(0)));
+    fs::remove(filename);
+}
+
+void BM_ParseMps(benchmark::State& state) {
+    const std::string& path = instance_path(state.range(0));
+    size_t nonzeros = 0;
+    for (auto _ : state) {
+        auto lp = mps::parse_mps(path);
+        nonzeros = model_nonzeros(*lp);
+        benchmark::DoNotOptimize(lp.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(fs::file_size(path)) * state.iterations());
+    set_nnz_rate(state, nonzeros);
+    state.SetLabel(instance_label(state.range(0)));
+}
+
+} // namespace
+
+// Arg 0: instance (0 = 50v-10.mps, 1..3 = synthetic with 1k, 10k, 100k columns)
+BENCHMARK(BM_Tokenize)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseColumnsSection)->ArgsProduct({{0, 1, 2, 3}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BuildMatrices)->ArgsProduct({{0, 1, 2, 3}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SaveCooMatrix)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SaveVector)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParseMps)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    for (const auto& entry : synthetic_paths()) {
+        fs::remove(entry.second);
+    }
+    return 0;
+}
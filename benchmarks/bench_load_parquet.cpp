@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include "bench_common.h"
+#include "lp_snapshot.h"
+#include "mps_parser.h"
+#include "parquet_reader.h"
+#include "parquet_writer.h"
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string instance_path() {
+    return mps_files_dir() + "/50v-10.mps";
+}
+
+// Converts the instance once, with a snapshot; the directories are removed again in main
+const std::string& parquet_dir() {
+    static const std::string dir = [] {
+        auto lp = mps::parse_mps(instance_path());
+        mps::OutputOptions options;
+        options.snapshot = true;
+        return std::get<0>(mps::save_lp_to_parquet(*lp, "bench_load_50v-10", options));
+    }();
+    return dir;
+}
+
+// The same instance as uncompressed Feather files
+const std::string& feather_dir() {
+    static const std::string dir = [] {
+        auto lp = mps::parse_mps(instance_path());
+        mps::OutputOptions options;
+        options.format = mps::OutputFormat::Feather;
+        return std::get<0>(mps::save_lp_to_parquet(*lp, "bench_load_50v-10_feather", options));
+    }();
+    return dir;
+}
+
+void BM_ParseMps(benchmark::State& state) {
+    for (auto _ : state) {
+        auto lp = mps::parse_mps(instance_path());
+        benchmark::DoNotOptimize(lp.get());
+    }
+    state.SetLabel("50v-10.mps");
+}
+
+void BM_LoadParquet(benchmark::State& state) {
+    const std::string& dir = parquet_dir();
+    for (auto _ : state) {
+        auto lp = mps::load_lp_from_parquet(dir);
+        benchmark::DoNotOptimize(lp.get());
+    }
+    state.SetLabel("50v-10 parquet");
+}
+
+void BM_LoadFeather(benchmark::State& state) {
+    const std::string& dir = feather_dir();
+    for (auto _ : state) {
+        auto lp = mps::load_lp_from_parquet(dir);
+        benchmark::DoNotOptimize(lp.get());
+    }
+    state.SetLabel("50v-10 feather");
+}
+
+// Mapping the snapshot and touching every array through the views
+void BM_OpenSnapshot(benchmark::State& state) {
+    const std::string path = (fs::path(parquet_dir()) / mps::kSnapshotFileName).string();
+    for (auto _ : state) {
+        mps::LpSnapshot snapshot(path);
+        benchmark::DoNotOptimize(snapshot.get_A_ineq().sum() + snapshot.get_A_eq().sum() + snapshot.get_c().sum());
+    }
+    state.SetLabel("50v-10 snapshot");
+}
+
+// Snapshot copied into an owning LpData, as a drop-in for load_lp_from_parquet
+void BM_SnapshotToLpData(benchmark::State& state) {
+    const std::string path = (fs::path(parquet_dir()) / mps::kSnapshotFileName).string();
+    for (auto _ : state) {
+        auto lp = mps::LpSnapshot(path).to_lp_data();
+        benchmark::DoNotOptimize(lp.get());
+    }
+    state.SetLabel("50v-10 snapshot");
+}
+
+} // namespace
+
+BENCHMARK(BM_ParseMps)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadParquet)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadFeather)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_OpenSnapshot)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SnapshotToLpData)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    fs::remove_all(parquet_dir());
+    fs::remove_all(feather_dir());
+    return 0;
+}
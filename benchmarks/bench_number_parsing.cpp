@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include "bench_common.h"
+#include "mapped_file.h"
+#include "mps_tokenizer.h"
+#include "number_parser.h"
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Every numeric field of the COLUMNS section of 50v-10.mps, in file order
+const std::vector<std::string>& column_values() {
+    static const std::vector<std::string> values = [] {
+        std::vector<std::string> fields;
+        mps::MappedFile file(mps_files_dir() + "/50v-10.mps");
+        mps::LineReader lines(file.view());
+        std::string_view line, token;
+        bool in_columns = false;
+        while (lines.next(line)) {
+            line = mps::trim_view(line);
+            if (line == "COLUMNS") { in_columns = true; continue; }
+            if (line == "RHS") break;
+            if (!in_columns || line.empty() || line[0] == '*') continue;
+
+            mps::TokenCursor tokens(line);
+            tokens.next(token);  // column name
+            for (int field = 1; tokens.next(token); ++field) {
+                if (token == "'MARKER'") break;
+                if (field % 2 == 0) fields.emplace_back(token);
+            }
+        }
+        return fields;
+    }();
+    return values;
+}
+
+size_t total_bytes(const std::vector<std::string>& fields) {
+    size_t bytes = 0;
+    for (const auto& field : fields) bytes += field.size();
+    return bytes;
+}
+
+void BM_StreamExtraction(benchmark::State& state) {
+    const auto& fields = column_values();
+    std::istringstream iss;
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& field : fields) {
+            iss.clear();
+            iss.str(field);
+            double value;
+            iss >> value;
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * fields.size());
+    state.SetBytesProcessed(state.iterations() * total_bytes(fields));
+}
+BENCHMARK(BM_StreamExtraction);
+
+void BM_Strtod(benchmark::State& state) {
+    const auto& fields = column_values();
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (const auto& field : fields) {
+            sum += std::strtod(field.c_str(), nullptr);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * fields.size());
+    state.SetBytesProcessed(state.iterations() * total_bytes(fields));
+}
+BENCHMARK(BM_Strtod);
+
+void BM_ParseDouble(benchmark::State& state) {
+    const auto& fields = column_values();
+    std::vector<std::string_view> views(fields.begin(), fields.end());
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (std::string_view field : views) {
+            sum += mps::parse_double(field);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * views.size());
+    state.SetBytesProcessed(state.iterations() * total_bytes(fields));
+}
+BENCHMARK(BM_ParseDouble);
+
+} // namespace
+
+BENCHMARK_MAIN();
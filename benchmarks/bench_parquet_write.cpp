@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include "bench_common.h"
+#include "mps_parser.h"
+#include "parquet_writer.h"
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// A_ineq of 50v-10.mps, parsed once
+const Eigen::SparseMatrix<double>& instance_matrix() {
+    static const Eigen::SparseMatrix<double> matrix =
+        mps::parse_mps(mps_files_dir() + "/50v-10.mps")->get_A_ineq();
+    return matrix;
+}
+
+// 100k x 100k with ~2M nonzeros: small integer coefficients, like most MIPLIB rows
+const Eigen::SparseMatrix<double>& synthetic_matrix() {
+    static const Eigen::SparseMatrix<double> matrix = [] {
+        const int n = 100000;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> index(0, n - 1);
+        std::uniform_int_distribution<int> coefficient(-20, 20);
+        std::vector<Eigen::Triplet<double>> triplets;
+        for (int k = 0; k < 2000000; ++k) {
+            triplets.emplace_back(index(rng), index(rng), coefficient(rng));
+        }
+        Eigen::SparseMatrix<double> m(n, n);
+        m.setFromTriplets(triplets.begin(), triplets.end());
+        return m;
+    }();
+    return matrix;
+}
+
+const char* kCodecNames[] = {"none", "snappy", "zstd", "lz4"};
+
+// Args: matrix (0 = 50v-10, 1 = synthetic), codec, dictionary, byte_stream_split, row group size
+void BM_SaveCooMatrix(benchmark::State& state) {
+    const auto& matrix = state.range(0) == 0 ? instance_matrix() : synthetic_matrix();
+    mps::OutputOptions options;
+    options.codec = mps::parse_compression_codec(kCodecNames[state.range(1)]);
+    options.parquet.dictionary = state.range(2) != 0;
+    options.parquet.byte_stream_split = state.range(3) != 0;
+    options.row_group_size = state.range(4);
+
+    const std::string filename = (fs::temp_directory_path() / "bench_parquet_write.parquet").string();
+    for (auto _ : state) {
+        auto status = mps::save_coo_matrix(matrix, filename, options);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            break;
+        }
+    }
+
+    state.SetLabel(std::string(kCodecNames[state.range(1)]) +
+                   (options.parquet.dictionary ? " dict" : "") + (options.parquet.byte_stream_split ? " bss" : ""));
+    state.counters["file_bytes"] = static_cast<double>(fs::file_size(filename));
+    state.counters["nnz/s"] = benchmark::Counter(static_cast<double>(matrix.nonZeros()) * state.iterations(),
+                                                 benchmark::Counter::kIsRate);
+    fs::remove(filename);
+}
+BENCHMARK(BM_SaveCooMatrix)
+    ->ArgNames({"matrix", "codec", "dict", "bss", "row_group"})
+    ->ArgsProduct({{0, 1}, {0, 1, 2, 3}, {0, 1}, {0, 1}, {1024, 1 << 20}})
+    ->Unit(benchmark::kMillisecond);
+
+// The same matrices as Arrow IPC (Feather) files. Args: matrix, codec (none, zstd or lz4)
+void BM_SaveCooMatrixFeather(benchmark::State& state) {
+    const auto& matrix = state.range(0) == 0 ? instance_matrix() : synthetic_matrix();
+    mps::OutputOptions options;
+    options.format = mps::OutputFormat::Feather;
+    options.codec = mps::parse_compression_codec(kCodecNames[state.range(1)]);
+
+    const std::string filename = (fs::temp_directory_path() / "bench_parquet_write.feather").string();
+    for (auto _ : state) {
+        auto status = mps::save_coo_matrix(matrix, filename, options);
+        if (!status.ok()) {
+            state.SkipWithError(status.ToString().c_str());
+            break;
+        }
+    }
+
+    state.SetLabel(std::string("feather ") + kCodecNames[state.range(1)]);
+    state.counters["file_bytes"] = static_cast<double>(fs::file_size(filename));
+    state.counters["nnz/s"] = benchmark::Counter(static_cast<double>(matrix.nonZeros()) * state.iterations(),
+                                                 benchmark::Counter::kIsRate);
+    fs::remove(filename);
+}
+BENCHMARK(BM_SaveCooMatrixFeather)
+    ->ArgNames({"matrix", "codec"})
+    ->ArgsProduct({{0, 1}, {0, 2, 3}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
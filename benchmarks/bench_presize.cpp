@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+#include "bench_common.h"
+#include "mps_parser.h"
+#include <atomic>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <sys/resource.h>
+
+// Global allocation counters, fed by the replaced operator new/delete below
+namespace {
+
+std::atomic<size_t> g_allocations{0};
+std::atomic<size_t> g_live_bytes{0};
+std::atomic<size_t> g_peak_bytes{0};
+
+void* counted_alloc(size_t size) {
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const size_t live = g_live_bytes.fetch_add(malloc_usable_size(ptr), std::memory_order_relaxed) +
+                        malloc_usable_size(ptr);
+    size_t peak = g_peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    return ptr;
+}
+
+void counted_free(void* ptr) {
+    if (!ptr) return;
+    g_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+    std::free(ptr);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return counted_alloc(size); }
+void* operator new[](size_t size) { return counted_alloc(size); }
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { counted_free(ptr); }
+
+namespace {
+
+// MPS_BENCH_INSTANCE selects a larger model; 50v-10.mps otherwise
+std::string instance_path() {
+    if (const char* path = std::getenv("MPS_BENCH_INSTANCE")) return path;
+    return mps_files_dir() + "/50v-10.mps";
+}
+
+// Allocator calls and peak heap bytes of one parse, plus the process-wide peak RSS
+void BM_ParseMps(benchmark::State& state) {
+    mps::ParseOptions options;
+    options.presize = state.range(0) != 0;
+    options.num_threads = static_cast<int>(state.range(1));
+    const std::string path = instance_path();
+
+    size_t allocations = 0;
+    size_t peak_bytes = 0;
+    for (auto _ : state) {
+        const size_t allocations_before = g_allocations.load();
+        g_peak_bytes.store(g_live_bytes.load());
+        const size_t live_before = g_live_bytes.load();
+
+        auto lp = mps::parse_mps(path, options);
+        benchmark::DoNotOptimize(lp.get());
+
+        allocations = g_allocations.load() - allocations_before;
+        peak_bytes = g_peak_bytes.load() - live_before;
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    state.counters["allocations"] = static_cast<double>(allocations);
+    state.counters["peak_heap_MiB"] = peak_bytes / (1024.0 * 1024.0);
+    state.counters["max_rss_MiB"] = usage.ru_maxrss / 1024.0;
+    state.SetLabel(options.presize ? "presize" : "grow");
+}
+
+} // namespace
+
+// Args: presize (0/1), COLUMNS threads. max_rss is monotonic over the process; filter to one
+// benchmark (--benchmark_filter) to compare peak RSS between the modes.
+BENCHMARK(BM_ParseMps)->ArgsProduct({{0, 1}, {1, 4}})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,293 @@
+// Python extension module "mps": parse_mps and load_lp_from_parquet returning an LpData
+// whose vectors are NumPy arrays and whose constraint matrices are scipy.sparse.csc_matrix
+// objects, all viewing the C++ buffers. The views keep the LpData alive and are read-only.
+// Written against the CPython and NumPy C APIs, so building needs nothing else.
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <numpy/arrayobject.h>
+
+#include "lp_data.h"
+#include "mps_parser.h"
+#include "parquet_reader.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+static_assert(std::is_same_v<Eigen::SparseMatrix<double>::StorageIndex, int>, "index arrays are exposed as NPY_INT");
+
+// Owned reference, released with Py_XDECREF
+struct PyDecRef {
+    void operator()(PyObject* object) const { Py_XDECREF(object); }
+};
+using PyRef = std::unique_ptr<PyObject, PyDecRef>;
+
+// Python object owning one model
+struct LpDataObject {
+    PyObject_HEAD
+    mps::LpData* lp;
+};
+
+PyTypeObject LpDataType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+const mps::LpData& model(PyObject* self) {
+    return *reinterpret_cast<LpDataObject*>(self)->lp;
+}
+
+void lp_data_dealloc(PyObject* self) {
+    delete reinterpret_cast<LpDataObject*>(self)->lp;
+    Py_TYPE(self)->tp_free(self);
+}
+
+PyObject* wrap(std::unique_ptr<mps::LpData> lp) {
+    auto* object = PyObject_New(LpDataObject, &LpDataType);
+    if (!object) return nullptr;
+    object->lp = lp.release();
+    return reinterpret_cast<PyObject*>(object);
+}
+
+// One-dimensional read-only NumPy view of count elements at data, holding a reference
+// to owner. NumPy allocates its own buffer for a null pointer, which Eigen hands out
+// for empty arrays, so those point at a static element instead.
+PyObject* array_view(const void* data, npy_intp count, int type_num, PyObject* owner) {
+    static const double empty = 0.0;
+    PyRef array(PyArray_SimpleNewFromData(1, &count, type_num, const_cast<void*>(data ? data : &empty)));
+    if (!array) return nullptr;
+    auto* ndarray = reinterpret_cast<PyArrayObject*>(array.get());
+    PyArray_CLEARFLAGS(ndarray, NPY_ARRAY_WRITEABLE);
+    Py_INCREF(owner);
+    if (PyArray_SetBaseObject(ndarray, owner) < 0) return nullptr;  // steals owner either way
+    return array.release();
+}
+
+PyObject* vector_view(const Eigen::VectorXd& vector, PyObject* owner) {
+    return array_view(vector.data(), vector.size(), NPY_DOUBLE, owner);
+}
+
+// scipy.sparse.csc_matrix over Eigen's compressed column storage. SciPy keeps int32
+// indices as given, so only an uncompressed matrix (never produced by the parser or the
+// Parquet loader) costs a copy, which the arrays then own through a capsule.
+PyObject* csc_view(const Eigen::SparseMatrix<double>& matrix, PyObject* owner) {
+    const Eigen::SparseMatrix<double>* source = &matrix;
+    Py_INCREF(owner);
+    PyRef base(owner);
+    if (!matrix.isCompressed()) {
+        auto* copy = new Eigen::SparseMatrix<double>(matrix);
+        copy->makeCompressed();
+        base.reset(PyCapsule_New(copy, nullptr, [](PyObject* capsule) {
+            delete static_cast<Eigen::SparseMatrix<double>*>(PyCapsule_GetPointer(capsule, nullptr));
+        }));
+        if (!base) {
+            delete copy;
+            return nullptr;
+        }
+        source = copy;
+    }
+    const npy_intp nnz = source->nonZeros();
+    PyRef data(array_view(source->valuePtr(), nnz, NPY_DOUBLE, base.get()));
+    PyRef indices(array_view(source->innerIndexPtr(), nnz, NPY_INT, base.get()));
+    PyRef indptr(array_view(source->outerIndexPtr(), source->outerSize() + 1, NPY_INT, base.get()));
+    if (!data || !indices || !indptr) return nullptr;
+
+    PyRef sparse(PyImport_ImportModule("scipy.sparse"));
+    if (!sparse) return nullptr;
+    PyRef csc_matrix(PyObject_GetAttrString(sparse.get(), "csc_matrix"));
+    PyRef args(Py_BuildValue("((OOO))", data.get(), indices.get(), indptr.get()));
+    PyRef kwargs(Py_BuildValue("{s:(nn),s:O}", "shape", static_cast<Py_ssize_t>(source->rows()),
+                               static_cast<Py_ssize_t>(source->cols()), "copy", Py_False));
+    if (!csc_matrix || !args || !kwargs) return nullptr;
+    return PyObject_Call(csc_matrix.get(), args.get(), kwargs.get());
+}
+
+// Properties viewing one vector or matrix of the LpData they are read from
+template <const Eigen::VectorXd& (mps::LpData::*Getter)() const>
+PyObject* get_vector(PyObject* self, void*) {
+    return vector_view((model(self).*Getter)(), self);
+}
+
+template <const Eigen::SparseMatrix<double>& (mps::LpData::*Getter)() const>
+PyObject* get_matrix(PyObject* self, void*) {
+    return csc_view((model(self).*Getter)(), self);
+}
+
+PyObject* get_n_vars(PyObject* self, void*) {
+    return PyLong_FromLong(model(self).get_n_vars());
+}
+
+PyObject* get_bounds(PyObject* self, void*) {
+    PyRef lb(vector_view(model(self).get_lb(), self));
+    PyRef ub(vector_view(model(self).get_ub(), self));
+    if (!lb || !ub) return nullptr;
+    return PyTuple_Pack(2, lb.get(), ub.get());
+}
+
+PyObject* get_obj_offset(PyObject* self, void*) {
+    return PyFloat_FromDouble(model(self).get_obj_offset());
+}
+
+PyObject* get_parse_time_seconds(PyObject* self, void*) {
+    return PyFloat_FromDouble(model(self).get_parse_time_seconds());
+}
+
+PyObject* get_col_names(PyObject* self, void*) {
+    const auto& names = model(self).get_col_names();
+    PyRef list(PyList_New(static_cast<Py_ssize_t>(names.size())));
+    if (!list) return nullptr;
+    for (size_t i = 0; i < names.size(); ++i) {
+        PyObject* name = PyUnicode_FromStringAndSize(names[i].data(), static_cast<Py_ssize_t>(names[i].size()));
+        if (!name) return nullptr;
+        PyList_SET_ITEM(list.get(), static_cast<Py_ssize_t>(i), name);
+    }
+    return list.release();
+}
+
+// Same layout as parse_stats in metadata.json
+PyObject* get_parse_stats(PyObject* self, void*) {
+    const std::string text = nlohmann::json(model(self).get_parse_stats()).dump();
+    PyRef json(PyImport_ImportModule("json"));
+    if (!json) return nullptr;
+    return PyObject_CallMethod(json.get(), "loads", "s#", text.data(), static_cast<Py_ssize_t>(text.size()));
+}
+
+PyObject* lp_data_repr(PyObject* self) {
+    const mps::LpData& lp = model(self);
+    const std::string text = "LpData(n_vars=" + std::to_string(lp.get_n_vars()) +
+                             ", n_eq=" + std::to_string(lp.get_b_eq().size()) +
+                             ", n_ineq=" + std::to_string(lp.get_b_ineq().size()) +
+                             ", nnz=" + std::to_string(lp.get_A_eq().nonZeros() + lp.get_A_ineq().nonZeros()) + ")";
+    return PyUnicode_FromStringAndSize(text.data(), static_cast<Py_ssize_t>(text.size()));
+}
+
+PyGetSetDef lp_data_getset[] = {
+    {"n_vars", get_n_vars, nullptr, nullptr, nullptr},
+    {"c", get_vector<&mps::LpData::get_c>, nullptr, nullptr, nullptr},
+    {"lb", get_vector<&mps::LpData::get_lb>, nullptr, nullptr, nullptr},
+    {"ub", get_vector<&mps::LpData::get_ub>, nullptr, nullptr, nullptr},
+    {"bounds", get_bounds, nullptr, "(lb, ub)", nullptr},
+    {"A_eq", get_matrix<&mps::LpData::get_A_eq>, nullptr, nullptr, nullptr},
+    {"b_eq", get_vector<&mps::LpData::get_b_eq>, nullptr, nullptr, nullptr},
+    {"A_ineq", get_matrix<&mps::LpData::get_A_ineq>, nullptr, nullptr, nullptr},
+    {"b_ineq", get_vector<&mps::LpData::get_b_ineq>, nullptr, nullptr, nullptr},
+    {"obj_offset", get_obj_offset, nullptr, nullptr, nullptr},
+    {"col_names", get_col_names, nullptr, nullptr, nullptr},
+    {"parse_time_seconds", get_parse_time_seconds, nullptr, nullptr, nullptr},
+    {"parse_stats", get_parse_stats, nullptr, "ParseStats as a dict, as in metadata.json", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+// Runs load without the GIL and wraps its model; C++ exceptions become Python ones
+template <typename Load>
+PyObject* load_without_gil(Load load) {
+    std::unique_ptr<mps::LpData> lp;
+    PyObject* error_type = nullptr;
+    std::string error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        lp = load();
+    } catch (const std::invalid_argument& e) {
+        error_type = PyExc_ValueError;
+        error = e.what();
+    } catch (const std::bad_alloc&) {
+        error_type = PyExc_MemoryError;
+    } catch (const std::exception& e) {
+        error_type = PyExc_RuntimeError;
+        error = e.what();
+    } catch (...) {
+        // Nothing may cross the C API boundary; the error is set once the GIL is back
+        error_type = PyExc_RuntimeError;
+        error = "unknown C++ exception";
+    }
+    Py_END_ALLOW_THREADS
+    if (error_type) {
+        PyErr_SetString(error_type, error.c_str());
+        return nullptr;
+    }
+    return wrap(std::move(lp));
+}
+
+PyObject* parse_mps(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"path", "reader", "threads", "presize", nullptr};
+    PyObject* path_bytes = nullptr;
+    const char* reader = "mmap";
+    int threads = 1;
+    int presize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&|sip", const_cast<char**>(keywords),
+                                     PyUnicode_FSConverter, &path_bytes, &reader, &threads, &presize)) {
+        return nullptr;
+    }
+    PyRef path_owner(path_bytes);
+    const std::string path = PyBytes_AS_STRING(path_bytes);
+
+    mps::ParseOptions options;
+    if (std::string(reader) == "mmap") {
+        options.backend = mps::ReaderBackend::Mmap;
+    } else if (std::string(reader) == "stream") {
+        options.backend = mps::ReaderBackend::Stream;
+    } else {
+        return PyErr_Format(PyExc_ValueError, "Unknown reader: %s", reader);
+    }
+    options.num_threads = threads;
+    options.presize = presize != 0;
+    return load_without_gil([&] { return mps::parse_mps(path, options); });
+}
+
+PyObject* load_lp_from_parquet(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"output_dir", nullptr};
+    PyObject* dir_bytes = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O&", const_cast<char**>(keywords),
+                                     PyUnicode_FSConverter, &dir_bytes)) {
+        return nullptr;
+    }
+    PyRef dir_owner(dir_bytes);
+    const std::string output_dir = PyBytes_AS_STRING(dir_bytes);
+    return load_without_gil([&] { return mps::load_lp_from_parquet(output_dir); });
+}
+
+PyMethodDef module_methods[] = {
+    {"parse_mps", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(parse_mps)), METH_VARARGS | METH_KEYWORDS,
+     "parse_mps(path, reader='mmap', threads=1, presize=False)\n"
+     "Parses an MPS file (.mps, .gz, .bz2 or .zst) without holding the GIL.\n"
+     "reader is 'mmap' or 'stream'; threads parses COLUMNS in parallel (0 = all cores)."},
+    {"load_lp_from_parquet", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(load_lp_from_parquet)),
+     METH_VARARGS | METH_KEYWORDS,
+     "load_lp_from_parquet(output_dir)\n"
+     "Loads a directory written by parse_and_save without holding the GIL."},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef module_def = {
+    PyModuleDef_HEAD_INIT,
+    "mps",
+    "MPS parser returning NumPy/SciPy views of the parsed model",
+    -1,
+    module_methods,
+};
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_mps() {
+    import_array();
+
+    LpDataType.tp_name = "mps.LpData";
+    LpDataType.tp_basicsize = sizeof(LpDataObject);
+    LpDataType.tp_dealloc = lp_data_dealloc;
+    LpDataType.tp_repr = lp_data_repr;
+    LpDataType.tp_flags = Py_TPFLAGS_DEFAULT;
+    LpDataType.tp_doc = "Parsed LP model; created by parse_mps and load_lp_from_parquet";
+    LpDataType.tp_getset = lp_data_getset;
+    if (PyType_Ready(&LpDataType) < 0) return nullptr;
+
+    PyRef module(PyModule_Create(&module_def));
+    if (!module) return nullptr;
+    Py_INCREF(&LpDataType);
+    if (PyModule_AddObject(module.get(), "LpData", reinterpret_cast<PyObject*>(&LpDataType)) < 0) {
+        Py_DECREF(&LpDataType);
+        return nullptr;
+    }
+    return module.release();
+}
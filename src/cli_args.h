@@ -0,0 +1,63 @@
+#ifndef MPS_CLI_ARGS_H
+#define MPS_CLI_ARGS_H
+
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace mps {
+
+/**
+ * Parses the value of a numeric command-line option. The whole value must be a decimal
+ * integer within [min_value, max_value]; "12abc", "-1" for an unsigned type or an
+ * out-of-range number are rejected.
+ * @param option Option name, for the error message (e.g. "--threads")
+ * @throws std::invalid_argument naming the option and the accepted range
+ */
+template <typename Int>
+Int parse_int_option(const std::string& option, const std::string& value, Int min_value,
+                     Int max_value = std::numeric_limits<Int>::max()) {
+    Int result{};
+    const char* end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+    if (value.empty() || ec != std::errc() || ptr != end || result < min_value || result > max_value) {
+        std::string range = "an integer >= " + std::to_string(min_value);
+        if (max_value != std::numeric_limits<Int>::max()) {
+            range = "an integer from " + std::to_string(min_value) + " to " + std::to_string(max_value);
+        }
+        throw std::invalid_argument(option + " expects " + range + ", got '" + value + "'");
+    }
+    return result;
+}
+
+/**
+ * Parses the value of a floating-point command-line option. The whole value must be a
+ * decimal number within [min_value, max_value]; "0.5abc", "nan" or an out-of-range number
+ * are rejected.
+ * @param option Option name, for the error message (e.g. "--density")
+ * @throws std::invalid_argument naming the option and the accepted range
+ */
+inline double parse_double_option(const std::string& option, const std::string& value, double min_value,
+                                  double max_value = std::numeric_limits<double>::max()) {
+    double result = 0.0;
+    const char* end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+    // Written so that NaN fails the range test
+    if (value.empty() || ec != std::errc() || ptr != end || !(result >= min_value && result <= max_value)) {
+        auto shortest = [](double number) {
+            char text[32];
+            return std::string(text, std::to_chars(text, text + sizeof(text), number).ptr);
+        };
+        std::string range = "a number >= " + shortest(min_value);
+        if (max_value != std::numeric_limits<double>::max()) {
+            range = "a number from " + shortest(min_value) + " to " + shortest(max_value);
+        }
+        throw std::invalid_argument(option + " expects " + range + ", got '" + value + "'");
+    }
+    return result;
+}
+
+} // namespace mps
+
+#endif // MPS_CLI_ARGS_H
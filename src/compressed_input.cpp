@@ -0,0 +1,396 @@
+#include "compressed_input.h"
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+#ifdef MPS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef MPS_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef MPS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace mps {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t kInputChunkBytes = 1 << 20;
+constexpr size_t kOutputBlockBytes = 1 << 20;
+constexpr size_t kBlocksAhead = 4;  // decoded blocks the producer may queue before it waits
+
+const char* compression_name(Compression compression) {
+    switch (compression) {
+        case Compression::Gzip: return "gzip";
+        case Compression::Bzip2: return "bzip2";
+        case Compression::Zstd: return "zstd";
+        default: return "plain";
+    }
+}
+
+// One compressed stream format. decode() advances the input and output cursors and
+// returns true when the current stream (gzip member, bzip2 stream, zstd frame) ended.
+class Decoder {
+public:
+    virtual ~Decoder() = default;
+    virtual bool decode(const char*& in, size_t& in_avail, char*& out, size_t& out_avail) = 0;
+    // Prepares for a following concatenated stream
+    virtual void reset() = 0;
+};
+
+#ifdef MPS_HAVE_ZLIB
+class GzipDecoder : public Decoder {
+public:
+    GzipDecoder() {
+        // 15 + 32: maximum window, accept both gzip and zlib headers
+        if (inflateInit2(&stream_, 15 + 32) != Z_OK) {
+            throw std::runtime_error("Failed to initialize zlib");
+        }
+    }
+    ~GzipDecoder() override { inflateEnd(&stream_); }
+
+    bool decode(const char*& in, size_t& in_avail, char*& out, size_t& out_avail) override {
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+        stream_.avail_in = static_cast<uInt>(in_avail);
+        stream_.next_out = reinterpret_cast<Bytef*>(out);
+        stream_.avail_out = static_cast<uInt>(out_avail);
+        const int ret = inflate(&stream_, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            throw std::runtime_error(std::string("gzip decoding failed: ") + (stream_.msg ? stream_.msg : "corrupt data"));
+        }
+        in += in_avail - stream_.avail_in;
+        in_avail = stream_.avail_in;
+        out += out_avail - stream_.avail_out;
+        out_avail = stream_.avail_out;
+        return ret == Z_STREAM_END;
+    }
+
+    void reset() override { inflateReset(&stream_); }
+
+private:
+    z_stream stream_{};
+};
+#endif
+
+#ifdef MPS_HAVE_BZIP2
+class Bzip2Decoder : public Decoder {
+public:
+    Bzip2Decoder() { init(); }
+    ~Bzip2Decoder() override { BZ2_bzDecompressEnd(&stream_); }
+
+    bool decode(const char*& in, size_t& in_avail, char*& out, size_t& out_avail) override {
+        stream_.next_in = const_cast<char*>(in);
+        stream_.avail_in = static_cast<unsigned int>(in_avail);
+        stream_.next_out = out;
+        stream_.avail_out = static_cast<unsigned int>(out_avail);
+        const int ret = BZ2_bzDecompress(&stream_);
+        if (ret != BZ_OK && ret != BZ_STREAM_END) {
+            throw std::runtime_error("bzip2 decoding failed: error " + std::to_string(ret));
+        }
+        in += in_avail - stream_.avail_in;
+        in_avail = stream_.avail_in;
+        out += out_avail - stream_.avail_out;
+        out_avail = stream_.avail_out;
+        return ret == BZ_STREAM_END;
+    }
+
+    void reset() override {
+        BZ2_bzDecompressEnd(&stream_);
+        init();
+    }
+
+private:
+    void init() {
+        stream_ = bz_stream{};
+        if (BZ2_bzDecompressInit(&stream_, 0, 0) != BZ_OK) {
+            throw std::runtime_error("Failed to initialize bzip2");
+        }
+    }
+
+    bz_stream stream_{};
+};
+#endif
+
+#ifdef MPS_HAVE_ZSTD
+class ZstdDecoder : public Decoder {
+public:
+    ZstdDecoder() : context_(ZSTD_createDCtx()) {
+        if (!context_) {
+            throw std::runtime_error("Failed to initialize zstd");
+        }
+    }
+    ~ZstdDecoder() override { ZSTD_freeDCtx(context_); }
+
+    bool decode(const char*& in, size_t& in_avail, char*& out, size_t& out_avail) override {
+        ZSTD_inBuffer input{in, in_avail, 0};
+        ZSTD_outBuffer output{out, out_avail, 0};
+        const size_t ret = ZSTD_decompressStream(context_, &output, &input);
+        if (ZSTD_isError(ret)) {
+            throw std::runtime_error(std::string("zstd decoding failed: ") + ZSTD_getErrorName(ret));
+        }
+        in += input.pos;
+        in_avail -= input.pos;
+        out += output.pos;
+        out_avail -= output.pos;
+        return ret == 0;  // frame complete and fully flushed
+    }
+
+    // The context starts the next frame by itself
+    void reset() override {}
+
+private:
+    ZSTD_DCtx* context_;
+};
+#endif
+
+std::unique_ptr<Decoder> make_decoder(Compression compression, const std::string& path) {
+    switch (compression) {
+#ifdef MPS_HAVE_ZLIB
+        case Compression::Gzip: return std::make_unique<GzipDecoder>();
+#endif
+#ifdef MPS_HAVE_BZIP2
+        case Compression::Bzip2: return std::make_unique<Bzip2Decoder>();
+#endif
+#ifdef MPS_HAVE_ZSTD
+        case Compression::Zstd: return std::make_unique<ZstdDecoder>();
+#endif
+        default:
+            throw std::runtime_error(std::string(compression_name(compression)) +
+                                     " input is not supported by this build: " + path);
+    }
+}
+
+// Streambuf over a compressed file. A producer thread reads and decodes the file into
+// fixed-size blocks and queues up to kBlocksAhead of them; underflow() hands the
+// blocks to the reader in order and returns consumed ones for reuse.
+class DecompressingStreamBuf : public std::streambuf {
+public:
+    DecompressingStreamBuf(const std::string& path, Compression compression)
+        : path_(path),
+          file_(std::fopen(path.c_str(), "rb"), &std::fclose),
+          decoder_(make_decoder(compression, path)) {
+        if (!file_) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        producer_ = std::thread([this] { produce(); });
+    }
+
+    ~DecompressingStreamBuf() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_ = true;
+        }
+        changed_.notify_all();
+        producer_.join();
+    }
+
+protected:
+    int_type underflow() override {
+        if (gptr() < egptr()) {
+            return traits_type::to_int_type(*gptr());
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!current_.empty()) {
+            free_.push_back(std::move(current_));
+            current_.clear();
+        }
+        changed_.notify_all();
+        changed_.wait(lock, [&] { return !ready_.empty() || done_; });
+        if (ready_.empty()) {
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+            setg(nullptr, nullptr, nullptr);
+            return traits_type::eof();
+        }
+        current_ = std::move(ready_.front());
+        ready_.pop_front();
+        lock.unlock();
+        changed_.notify_all();
+
+        setg(current_.data(), current_.data(), current_.data() + current_.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    void produce() {
+        try {
+            decode_file();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        changed_.notify_all();
+    }
+
+    // Takes an empty output block, waiting while the reader is kBlocksAhead behind.
+    // Returns false if the stream is being destroyed.
+    bool take_block(std::vector<char>& block) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [&] { return cancelled_ || ready_.size() < kBlocksAhead; });
+        if (cancelled_) return false;
+        if (!free_.empty()) {
+            block = std::move(free_.back());
+            free_.pop_back();
+        }
+        block.resize(kOutputBlockBytes);
+        return true;
+    }
+
+    void push_block(std::vector<char>& block, size_t size) {
+        block.resize(size);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(std::move(block));
+        }
+        changed_.notify_all();
+        block = std::vector<char>();
+    }
+
+    void decode_file() {
+        std::vector<char> input(kInputChunkBytes);
+        const char* in = input.data();
+        size_t in_avail = 0;
+        bool eof = false;
+        bool stream_end = false;
+
+        std::vector<char> block;
+        if (!take_block(block)) return;
+        char* out = block.data();
+        size_t out_avail = block.size();
+
+        for (;;) {
+            if (in_avail == 0 && !eof) {
+                in_avail = std::fread(input.data(), 1, input.size(), file_.get());
+                in = input.data();
+                if (in_avail == 0) {
+                    if (std::ferror(file_.get())) {
+                        throw std::runtime_error("Failed to read file: " + path_);
+                    }
+                    eof = true;
+                }
+            }
+            if (stream_end) {
+                if (in_avail == 0) break;  // clean end of the last stream
+                decoder_->reset();
+                stream_end = false;
+            }
+
+            const size_t in_before = in_avail;
+            const size_t out_before = out_avail;
+            stream_end = decoder_->decode(in, in_avail, out, out_avail);
+
+            if (out_avail == 0) {
+                push_block(block, block.size());
+                if (!take_block(block)) return;
+                out = block.data();
+                out_avail = block.size();
+            } else if (!stream_end && in_avail == in_before && out_avail == out_before) {
+                // No progress with room to write: the decoder needs input that is not there
+                throw std::runtime_error(std::string("Truncated ") +
+                                         (eof ? "compressed input: " : "or corrupt compressed input: ") + path_);
+            }
+        }
+        if (out_avail < block.size()) {
+            push_block(block, block.size() - out_avail);
+        }
+    }
+
+    std::string path_;
+    std::unique_ptr<FILE, int (*)(FILE*)> file_;
+    std::unique_ptr<Decoder> decoder_;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::vector<char>> ready_;
+    std::vector<std::vector<char>> free_;
+    std::vector<char> current_;
+    bool done_ = false;
+    bool cancelled_ = false;
+    std::exception_ptr error_;
+    std::thread producer_;  // started last, once every member above exists
+};
+
+class DecompressingIStream : public std::istream {
+public:
+    DecompressingIStream(const std::string& path, Compression compression)
+        : std::istream(nullptr), buffer_(path, compression) {
+        rdbuf(&buffer_);
+        // Rethrow decoding errors from getline and friends instead of just setting badbit
+        exceptions(std::ios::badbit);
+    }
+
+private:
+    DecompressingStreamBuf buffer_;
+};
+
+const char* const kCompressionSuffixes[] = {".gz", ".bz2", ".zst"};
+
+// File name without a trailing compression suffix
+std::string strip_compression_suffix(std::string name) {
+    for (const char* suffix : kCompressionSuffixes) {
+        const std::string s(suffix);
+        if (name.size() > s.size() && name.compare(name.size() - s.size(), s.size(), s) == 0) {
+            name.resize(name.size() - s.size());
+            break;
+        }
+    }
+    return name;
+}
+
+} // namespace
+
+Compression detect_compression(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    unsigned char magic[4] = {0, 0, 0, 0};
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    const std::streamsize n = file.gcount();
+
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return Compression::Gzip;
+    if (n >= 3 && magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h') return Compression::Bzip2;
+    if (n >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+        return Compression::Zstd;
+    }
+    return Compression::None;
+}
+
+std::unique_ptr<std::istream> open_mps_input(const std::string& path) {
+    const Compression compression = detect_compression(path);
+    if (compression == Compression::None) {
+        auto file = std::make_unique<std::ifstream>(path);
+        if (!file->is_open()) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        return file;
+    }
+    return std::make_unique<DecompressingIStream>(path, compression);
+}
+
+bool is_mps_file_name(const std::string& path) {
+    return fs::path(strip_compression_suffix(fs::path(path).filename().string())).extension() == ".mps";
+}
+
+std::string instance_name_from_path(const std::string& path) {
+    return fs::path(strip_compression_suffix(fs::path(path).filename().string())).stem().string();
+}
+
+} // namespace mps
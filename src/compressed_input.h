@@ -0,0 +1,45 @@
+#ifndef COMPRESSED_INPUT_H
+#define COMPRESSED_INPUT_H
+
+#include <istream>
+#include <memory>
+#include <string>
+
+namespace mps {
+
+// Container format of an MPS input file, detected from its leading magic bytes
+enum class Compression { None, Gzip, Bzip2, Zstd };
+
+/**
+ * Detects whether a file is gzip, bzip2 or zstd compressed.
+ * @param path Path to the file
+ * @return The compression format, or Compression::None for plain text
+ * @throws std::runtime_error if the file cannot be opened
+ */
+Compression detect_compression(const std::string& path);
+
+/**
+ * Opens an MPS file for sequential reading, decompressing it on the fly if needed.
+ * Compressed inputs are decoded in 1 MiB blocks by a background thread that runs
+ * a few blocks ahead of the reader, so decompression overlaps with parsing.
+ * Decoding errors are rethrown from the extraction that hits them.
+ * @param path Path to a plain, .gz, .bz2 or .zst MPS file
+ * @return A stream over the decompressed text
+ * @throws std::runtime_error if the file cannot be opened or its format was not compiled in
+ */
+std::unique_ptr<std::istream> open_mps_input(const std::string& path);
+
+/**
+ * Returns true for file names ending in .mps, optionally followed by .gz, .bz2 or .zst.
+ */
+bool is_mps_file_name(const std::string& path);
+
+/**
+ * Instance name of an MPS file: the file name without directories, compression
+ * suffix and .mps extension ("dir/50v-10.mps.gz" -> "50v-10").
+ */
+std::string instance_name_from_path(const std::string& path);
+
+} // namespace mps
+
+#endif // COMPRESSED_INPUT_H
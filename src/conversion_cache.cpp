@@ -0,0 +1,118 @@
+#include "conversion_cache.h"
+#include <nlohmann/json.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace mps {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+
+constexpr size_t kChunkBytes = 1 << 20;  // multiple of the 32-byte stripe
+constexpr size_t kStripeBytes = 32;
+
+inline uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t load_word(const unsigned char* p) {
+    uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+inline uint64_t mix_round(uint64_t acc, uint64_t input) {
+    return rotl(acc + input * kPrime2, 31) * kPrime1;
+}
+
+// Four independent multiply-rotate lanes over 32-byte stripes, so consecutive
+// words do not wait on each other; the tail and the length are folded in at the end
+class StreamingHash {
+public:
+    void update_stripes(const unsigned char* p, size_t n_stripes) {
+        for (size_t s = 0; s < n_stripes; ++s, p += kStripeBytes) {
+            lanes_[0] = mix_round(lanes_[0], load_word(p));
+            lanes_[1] = mix_round(lanes_[1], load_word(p + 8));
+            lanes_[2] = mix_round(lanes_[2], load_word(p + 16));
+            lanes_[3] = mix_round(lanes_[3], load_word(p + 24));
+        }
+        length_ += n_stripes * kStripeBytes;
+    }
+
+    uint64_t finish(const unsigned char* tail, size_t tail_bytes) {
+        uint64_t h = rotl(lanes_[0], 1) + rotl(lanes_[1], 7) + rotl(lanes_[2], 12) + rotl(lanes_[3], 18);
+        h ^= length_ + tail_bytes;
+        for (size_t i = 0; i < tail_bytes; ++i) {
+            h = rotl(h ^ (tail[i] * kPrime3), 11) * kPrime1;
+        }
+        // Final avalanche
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+private:
+    uint64_t lanes_[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    uint64_t length_ = 0;
+};
+
+} // namespace
+
+std::string hash_file(const std::string& path) {
+    std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    std::unique_ptr<unsigned char[]> buffer(new unsigned char[kChunkBytes]);
+    StreamingHash hash;
+    size_t filled = 0;
+    for (;;) {
+        filled = std::fread(buffer.get(), 1, kChunkBytes, file.get());
+        if (filled < kChunkBytes) break;
+        hash.update_stripes(buffer.get(), kChunkBytes / kStripeBytes);
+    }
+    if (std::ferror(file.get())) {
+        throw std::runtime_error("Failed to read file: " + path);
+    }
+
+    // Only the last chunk can be short
+    const size_t n_stripes = filled / kStripeBytes;
+    hash.update_stripes(buffer.get(), n_stripes);
+    const uint64_t value = hash.finish(buffer.get() + n_stripes * kStripeBytes, filled % kStripeBytes);
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+    return hex;
+}
+
+bool is_cached_conversion(const std::string& output_dir, const std::string& source_hash,
+                          const std::string& conversion_key) {
+    std::ifstream metadata_file(fs::path(output_dir) / "metadata.json");
+    if (!metadata_file.is_open()) {
+        return false;
+    }
+    json metadata = json::parse(metadata_file, nullptr, /*allow_exceptions=*/false);
+    if (!metadata.is_object()) {
+        return false;
+    }
+    return metadata.value("source_hash", "") == source_hash &&
+           metadata.value("converter_version", "") == kConverterVersion &&
+           metadata.value("conversion_key", "") == conversion_key;
+}
+
+} // namespace mps
@@ -0,0 +1,37 @@
+#ifndef CONVERSION_CACHE_H
+#define CONVERSION_CACHE_H
+
+#include <string>
+
+namespace mps {
+
+/**
+ * Version of the parser and Parquet writer output, recorded in metadata.json.
+ * Bump it whenever a change alters the files written for the same MPS input,
+ * so existing conversions stop matching the cache.
+ */
+inline constexpr const char* kConverterVersion = "mps-parquet-4";
+
+/**
+ * Computes a 64-bit content hash of a file, reading it in fixed-size chunks
+ * so memory use stays constant for multi-GB inputs. Not cryptographic.
+ * @param path Path to the file
+ * @return The hash as 16 lowercase hex digits
+ * @throws std::runtime_error if the file cannot be read
+ */
+std::string hash_file(const std::string& path);
+
+/**
+ * Checks whether an output directory holds a complete conversion of a source
+ * with the given content hash, written by this converter version with the given settings.
+ * @param output_dir Directory such as data/<instance>_parquet
+ * @param source_hash Result of hash_file() on the MPS file
+ * @param conversion_key conversion_key() of the write options, as recorded in metadata.json
+ * @return true if metadata.json matches the hash, kConverterVersion and the key
+ */
+bool is_cached_conversion(const std::string& output_dir, const std::string& source_hash,
+                          const std::string& conversion_key);
+
+} // namespace mps
+
+#endif // CONVERSION_CACHE_H
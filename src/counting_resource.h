@@ -0,0 +1,47 @@
+#ifndef COUNTING_RESOURCE_H
+#define COUNTING_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace mps {
+
+// Allocation calls and bytes that reached a memory resource
+struct AllocationStats {
+    size_t allocations = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * Forwards to an upstream memory resource, counting the allocations that pass through.
+ * Not thread-safe, like the monotonic arenas it usually sits under.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream_(upstream) {}
+
+    const AllocationStats& stats() const { return stats_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++stats_.allocations;
+        stats_.bytes += bytes;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        upstream_->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    AllocationStats stats_;
+};
+
+} // namespace mps
+
+#endif // COUNTING_RESOURCE_H
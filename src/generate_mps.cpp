@@ -0,0 +1,95 @@
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include "cli_args.h"
+#include "mps_generator.h"
+
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--rows N] [--cols N] [--density F] [--row-mix E,L,G]"
+              << " [--objective-density F] [--rhs-density F] [--range-density F] [--bound-density F]"
+              << " [--integer-fraction F] [--marker-block N] [--name-length N] [--pairs-per-line 1|2]"
+              << " [--seed N] [--name NAME] <output.mps | ->" << std::endl;
+}
+
+// Parses "E,L,G" row type weights
+static void parse_row_mix(const std::string& mix, mps::MpsGeneratorOptions& options) {
+    const size_t first = mix.find(',');
+    const size_t second = first == std::string::npos ? std::string::npos : mix.find(',', first + 1);
+    if (second == std::string::npos) {
+        throw std::invalid_argument("--row-mix expects three weights: E,L,G");
+    }
+    options.eq_weight = mps::parse_double_option("--row-mix", mix.substr(0, first), 0.0);
+    options.le_weight = mps::parse_double_option("--row-mix", mix.substr(first + 1, second - first - 1), 0.0);
+    options.ge_weight = mps::parse_double_option("--row-mix", mix.substr(second + 1), 0.0);
+}
+
+int main(int argc, char* argv[]) {
+    mps::MpsGeneratorOptions options;
+    std::string output_path;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            const bool has_value = i + 1 < argc;
+            if (arg == "--rows" && has_value) {
+                options.rows = mps::parse_int_option<int64_t>(arg, argv[++i], 0);
+            } else if (arg == "--cols" && has_value) {
+                options.columns = mps::parse_int_option<int64_t>(arg, argv[++i], 1);
+            } else if (arg == "--density" && has_value) {
+                options.density = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--row-mix" && has_value) {
+                parse_row_mix(argv[++i], options);
+            } else if (arg == "--objective-density" && has_value) {
+                options.objective_density = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--rhs-density" && has_value) {
+                options.rhs_density = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--range-density" && has_value) {
+                options.range_density = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--bound-density" && has_value) {
+                options.bound_density = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--integer-fraction" && has_value) {
+                options.integer_fraction = mps::parse_double_option(arg, argv[++i], 0.0, 1.0);
+            } else if (arg == "--marker-block" && has_value) {
+                options.marker_block = mps::parse_int_option<int64_t>(arg, argv[++i], 1);
+            } else if (arg == "--name-length" && has_value) {
+                options.name_length = mps::parse_int_option(arg, argv[++i], 1);
+            } else if (arg == "--pairs-per-line" && has_value) {
+                options.pairs_per_line = mps::parse_int_option(arg, argv[++i], 1, 2);
+            } else if (arg == "--seed" && has_value) {
+                options.seed = mps::parse_int_option<uint64_t>(arg, argv[++i], 0);
+            } else if (arg == "--name" && has_value) {
+                options.name = argv[++i];
+            } else if (output_path.empty() && (arg == "-" || arg.rfind("--", 0) != 0)) {
+                output_path = arg;
+            } else {
+                print_usage(argv[0]);
+                return 1;
+            }
+        }
+        if (output_path.empty()) {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        // "-" streams to stdout, e.g. into a compressor
+        if (output_path == "-") {
+            std::ios::sync_with_stdio(false);
+            mps::generate_mps(std::cout, options);
+            std::cout.flush();
+            return 0;
+        }
+        const mps::MpsGeneratorStats stats = mps::generate_mps_file(output_path, options);
+        std::cout << "Wrote " << output_path << ": " << options.rows << " rows, " << options.columns
+                  << " columns, " << stats.nonzeros << " nonzeros, " << stats.lines << " lines, "
+                  << stats.bytes << " bytes" << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
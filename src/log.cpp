@@ -0,0 +1,42 @@
+#include "log.h"
+#include <atomic>
+#include <climits>
+#include <mutex>
+
+namespace mps {
+
+namespace {
+
+// Lowest enabled level, or INT_MAX while there is no sink
+std::atomic<int> g_min_level{INT_MAX};
+std::mutex g_sink_mutex;
+LogSink g_sink;
+
+} // namespace
+
+void set_log_sink(LogSink sink, LogLevel min_level) {
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+    g_min_level.store(sink ? static_cast<int>(min_level) : INT_MAX, std::memory_order_relaxed);
+    g_sink = std::move(sink);
+}
+
+LogSink stream_log_sink(std::ostream& out) {
+    return [&out](LogLevel level, std::string_view message) {
+        if (level == LogLevel::Warning) out << "Warning: ";
+        else if (level == LogLevel::Error) out << "Error: ";
+        out << message << '\n';
+    };
+}
+
+bool log_enabled(LogLevel level) {
+    return static_cast<int>(level) >= g_min_level.load(std::memory_order_relaxed);
+}
+
+void write_log(LogLevel level, std::string_view message) {
+    std::lock_guard<std::mutex> lock(g_sink_mutex);
+    if (g_sink && log_enabled(level)) {
+        g_sink(level, message);
+    }
+}
+
+} // namespace mps
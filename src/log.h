@@ -0,0 +1,47 @@
+#ifndef MPS_LOG_H
+#define MPS_LOG_H
+
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace mps {
+
+// Severity of a library message; phase timings are Debug. Failures are thrown, not logged.
+enum class LogLevel { Debug, Info, Warning, Error };
+
+// Receives one complete message (no trailing newline). Calls are serialized, so a
+// sink shared by worker threads never sees two messages at once.
+using LogSink = std::function<void(LogLevel level, std::string_view message)>;
+
+/**
+ * Routes the library's messages at min_level and above to sink. The library is
+ * silent by default; an empty sink silences it again. Not meant to be called while
+ * other threads are parsing or saving.
+ */
+void set_log_sink(LogSink sink, LogLevel min_level = LogLevel::Info);
+
+// Sink writing one line per message to out, prefixing warnings and errors.
+// Lines are not flushed; out must outlive the sink.
+LogSink stream_log_sink(std::ostream& out);
+
+// True if a message at this level would reach a sink (one relaxed atomic load)
+bool log_enabled(LogLevel level);
+
+// Hands a formatted message to the sink
+void write_log(LogLevel level, std::string_view message);
+
+// Formats the arguments with operator<< and logs them, only if the level is enabled
+template <typename... Args>
+void log_message(LogLevel level, const Args&... args) {
+    if (!log_enabled(level)) return;
+    std::ostringstream message;
+    (message << ... << args);
+    write_log(level, message.str());
+}
+
+} // namespace mps
+
+#endif // MPS_LOG_H
@@ -1,4 +1,5 @@
 #include "lp_data.h"
+#include <utility>
 
 namespace mps {
 
@@ -25,4 +26,28 @@ LpData::LpData(int n_vars,
     , parse_time_seconds_(parse_time_seconds) {
 }
 
+LpData::LpData(int n_vars,
+               Eigen::VectorXd&& c,
+               std::pair<Eigen::VectorXd, Eigen::VectorXd>&& bounds,
+               Eigen::SparseMatrix<double>&& A_eq,
+               Eigen::VectorXd&& b_eq,
+               Eigen::SparseMatrix<double>&& A_ineq,
+               Eigen::VectorXd&& b_ineq,
+               double obj_offset,
+               std::vector<std::string>&& col_names,
+               double parse_time_seconds)
+    : n_vars_(n_vars)
+    , c_(std::move(c))
+    , lb_(std::move(bounds.first))
+    , ub_(std::move(bounds.second))
+    , b_eq_(std::move(b_eq))
+    , b_ineq_(std::move(b_ineq))
+    , obj_offset_(obj_offset)
+    , col_names_(std::move(col_names))
+    , parse_time_seconds_(parse_time_seconds) {
+    // SparseMatrix has no move constructor; swapping hands the buffers over without a copy
+    A_eq_.swap(A_eq);
+    A_ineq_.swap(A_ineq);
+}
+
 } // namespace mps 
\ No newline at end of file
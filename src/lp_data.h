@@ -1,6 +1,7 @@
 #ifndef LP_DATA_H
 #define LP_DATA_H
 
+#include "parse_stats.h"
 #include <Eigen/Sparse>
 #include <vector>
 #include <string>
@@ -20,6 +21,18 @@ public:
            const std::vector<std::string>& col_names,
            double parse_time_seconds = 0.0);
 
+    // Takes ownership of the model buffers instead of copying them
+    LpData(int n_vars,
+           Eigen::VectorXd&& c,
+           std::pair<Eigen::VectorXd, Eigen::VectorXd>&& bounds,
+           Eigen::SparseMatrix<double>&& A_eq,
+           Eigen::VectorXd&& b_eq,
+           Eigen::SparseMatrix<double>&& A_ineq,
+           Eigen::VectorXd&& b_ineq,
+           double obj_offset,
+           std::vector<std::string>&& col_names,
+           double parse_time_seconds = 0.0);
+
     // Getters
     int get_n_vars() const { return n_vars_; }
     const Eigen::VectorXd& get_c() const { return c_; }
@@ -32,6 +45,10 @@ public:
     double get_obj_offset() const { return obj_offset_; }
     const std::vector<std::string>& get_col_names() const { return col_names_; }
     double get_parse_time_seconds() const { return parse_time_seconds_; }
+    const ParseStats& get_parse_stats() const { return parse_stats_; }
+
+    // Filled in by parse_mps; empty for models built or loaded any other way
+    void set_parse_stats(ParseStats stats) { parse_stats_ = std::move(stats); }
 
 private:
     int n_vars_;
@@ -44,6 +61,7 @@ private:
     double obj_offset_;              // Objective function offset
     std::vector<std::string> col_names_;  // Variable names
     double parse_time_seconds_;      // Added parse time member
+    ParseStats parse_stats_;         // Per-phase timings and memory of the parse
 };
 
 } // namespace mps
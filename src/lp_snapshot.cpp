@@ -0,0 +1,287 @@
+#include "lp_snapshot.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace mps {
+
+namespace {
+
+using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+
+constexpr char kMagic[8] = {'L', 'P', 'S', 'N', 'A', 'P', '\0', '\0'};
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint64_t kAlignment = 64;  // cache line; also satisfies every element type
+
+// Position and element count of one array in the file
+struct ArrayEntry {
+    uint64_t offset;
+    uint64_t length;
+};
+
+// First bytes of a snapshot file, written as-is
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;   // kByteOrderMark as written by the producing machine
+    uint32_t index_bytes;  // sizeof(StorageIndex)
+    uint32_t n_arrays;
+    int64_t n_vars;
+    int64_t eq_rows, eq_cols;
+    int64_t ineq_rows, ineq_cols;
+    double obj_offset;
+    double parse_time_seconds;
+    uint64_t file_bytes;
+    ArrayEntry arrays[LpSnapshot::kArrayCount];
+};
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+size_t element_bytes(LpSnapshot::Array array) {
+    switch (array) {
+        case LpSnapshot::kAEqOuter:
+        case LpSnapshot::kAEqInner:
+        case LpSnapshot::kAIneqOuter:
+        case LpSnapshot::kAIneqInner:
+            return sizeof(StorageIndex);
+        case LpSnapshot::kNameOffsets:
+            return sizeof(uint64_t);
+        case LpSnapshot::kNameChars:
+            return 1;
+        default:
+            return sizeof(double);
+    }
+}
+
+uint64_t align_up(uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// Array contents to write
+struct ArraySource {
+    const void* data;
+    uint64_t length;
+};
+
+} // namespace
+
+uint64_t save_lp_snapshot(const LpData& lp_data, const std::string& path) {
+    // CSC arrays need compressed storage; the parser always produces it
+    Eigen::SparseMatrix<double> eq_copy, ineq_copy;
+    const Eigen::SparseMatrix<double>* A_eq = &lp_data.get_A_eq();
+    const Eigen::SparseMatrix<double>* A_ineq = &lp_data.get_A_ineq();
+    if (!A_eq->isCompressed()) {
+        eq_copy = *A_eq;
+        eq_copy.makeCompressed();
+        A_eq = &eq_copy;
+    }
+    if (!A_ineq->isCompressed()) {
+        ineq_copy = *A_ineq;
+        ineq_copy.makeCompressed();
+        A_ineq = &ineq_copy;
+    }
+
+    // Names packed back to back, name i spanning [offsets[i], offsets[i + 1])
+    const auto& col_names = lp_data.get_col_names();
+    std::vector<uint64_t> name_offsets;
+    name_offsets.reserve(col_names.size() + 1);
+    name_offsets.push_back(0);
+    std::string name_chars;
+    for (const auto& name : col_names) {
+        name_chars += name;
+        name_offsets.push_back(name_chars.size());
+    }
+
+    const ArraySource sources[LpSnapshot::kArrayCount] = {
+        {lp_data.get_c().data(), static_cast<uint64_t>(lp_data.get_c().size())},
+        {lp_data.get_lb().data(), static_cast<uint64_t>(lp_data.get_lb().size())},
+        {lp_data.get_ub().data(), static_cast<uint64_t>(lp_data.get_ub().size())},
+        {lp_data.get_b_eq().data(), static_cast<uint64_t>(lp_data.get_b_eq().size())},
+        {lp_data.get_b_ineq().data(), static_cast<uint64_t>(lp_data.get_b_ineq().size())},
+        {A_eq->outerIndexPtr(), static_cast<uint64_t>(A_eq->outerSize() + 1)},
+        {A_eq->innerIndexPtr(), static_cast<uint64_t>(A_eq->nonZeros())},
+        {A_eq->valuePtr(), static_cast<uint64_t>(A_eq->nonZeros())},
+        {A_ineq->outerIndexPtr(), static_cast<uint64_t>(A_ineq->outerSize() + 1)},
+        {A_ineq->innerIndexPtr(), static_cast<uint64_t>(A_ineq->nonZeros())},
+        {A_ineq->valuePtr(), static_cast<uint64_t>(A_ineq->nonZeros())},
+        {name_offsets.data(), name_offsets.size()},
+        {name_chars.data(), name_chars.size()},
+    };
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.index_bytes = sizeof(StorageIndex);
+    header.n_arrays = LpSnapshot::kArrayCount;
+    header.n_vars = lp_data.get_n_vars();
+    header.eq_rows = A_eq->rows();
+    header.eq_cols = A_eq->cols();
+    header.ineq_rows = A_ineq->rows();
+    header.ineq_cols = A_ineq->cols();
+    header.obj_offset = lp_data.get_obj_offset();
+    header.parse_time_seconds = lp_data.get_parse_time_seconds();
+    uint64_t offset = align_up(sizeof(FileHeader));
+    for (int i = 0; i < LpSnapshot::kArrayCount; ++i) {
+        header.arrays[i] = {offset, sources[i].length};
+        offset = align_up(offset + sources[i].length * element_bytes(static_cast<LpSnapshot::Array>(i)));
+    }
+    header.file_bytes = offset;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open output file: " + path);
+    }
+    const char padding[kAlignment] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    for (int i = 0; i < LpSnapshot::kArrayCount; ++i) {
+        out.write(padding, header.arrays[i].offset - written);
+        const uint64_t bytes = sources[i].length * element_bytes(static_cast<LpSnapshot::Array>(i));
+        if (bytes > 0) {
+            out.write(static_cast<const char*>(sources[i].data), static_cast<std::streamsize>(bytes));
+        }
+        written = header.arrays[i].offset + bytes;
+    }
+    out.write(padding, header.file_bytes - written);
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+    return header.file_bytes;
+}
+
+LpSnapshot::LpSnapshot(const std::string& path) : file_(path), path_(path) {
+    auto fail = [&](const std::string& reason) {
+        throw std::runtime_error("Invalid LP snapshot " + path + ": " + reason);
+    };
+
+    FileHeader header;
+    if (file_.size() < sizeof(header)) fail("file too short");
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) fail("not a snapshot");
+    if (header.byte_order != kByteOrderMark || header.index_bytes != sizeof(StorageIndex)) {
+        fail("written on an incompatible platform");
+    }
+    if (header.version != kVersion || header.n_arrays != kArrayCount) {
+        fail("unsupported version " + std::to_string(header.version));
+    }
+    if (header.file_bytes != file_.size()) fail("truncated");
+
+    for (int i = 0; i < kArrayCount; ++i) {
+        const ArrayEntry& entry = header.arrays[i];
+        // Compared by division: length * element size could wrap around
+        if (entry.offset % kAlignment != 0 || entry.offset > file_.size() ||
+            entry.length > (file_.size() - entry.offset) / element_bytes(static_cast<Array>(i))) {
+            fail("array " + std::to_string(i) + " out of bounds");
+        }
+        offsets_[i] = entry.offset;
+        lengths_[i] = entry.length;
+    }
+
+    if (header.n_vars < 0 || header.n_vars > std::numeric_limits<int>::max()) fail("invalid n_vars");
+    n_vars_ = static_cast<int>(header.n_vars);
+    eq_rows_ = header.eq_rows;
+    eq_cols_ = header.eq_cols;
+    ineq_rows_ = header.ineq_rows;
+    ineq_cols_ = header.ineq_cols;
+    obj_offset_ = header.obj_offset;
+    parse_time_seconds_ = header.parse_time_seconds;
+
+    // Shapes must agree with the array lengths before any view is handed out
+    const uint64_t n_vars = static_cast<uint64_t>(header.n_vars);
+    if (lengths_[kC] != n_vars || lengths_[kLb] != n_vars || lengths_[kUb] != n_vars) {
+        fail("vector length differs from n_vars");
+    }
+    constexpr int64_t kMaxIndex = std::numeric_limits<StorageIndex>::max();
+    auto check_matrix = [&](Array outer, int64_t rows, int64_t cols, Array rhs) {
+        if (rows < 0 || cols < 0 || rows > kMaxIndex || cols > kMaxIndex ||
+            lengths_[outer] != static_cast<uint64_t>(cols + 1) || lengths_[rhs] != static_cast<uint64_t>(rows) ||
+            lengths_[outer + 1] != lengths_[outer + 2] || data<StorageIndex>(outer)[0] != 0 ||
+            static_cast<uint64_t>(data<StorageIndex>(outer)[cols]) != lengths_[outer + 1]) {
+            fail("inconsistent matrix arrays");
+        }
+    };
+    check_matrix(kAEqOuter, eq_rows_, eq_cols_, kBEq);
+    check_matrix(kAIneqOuter, ineq_rows_, ineq_cols_, kBIneq);
+
+    // Name i spans [offsets[i], offsets[i + 1]) of the character blob
+    const uint64_t n_offsets = lengths_[kNameOffsets];
+    const uint64_t* name_offsets = data<uint64_t>(kNameOffsets);
+    if (n_offsets == 0 || n_offsets - 1 > static_cast<uint64_t>(std::numeric_limits<int>::max()) ||
+        name_offsets[0] != 0 || name_offsets[n_offsets - 1] > lengths_[kNameChars]) {
+        fail("inconsistent name table");
+    }
+}
+
+void LpSnapshot::validate() const {
+    auto fail = [&](const std::string& reason) {
+        throw std::runtime_error("Invalid LP snapshot " + path_ + ": " + reason);
+    };
+
+    // Eigen trusts the CSC arrays: the offsets must not decrease, and each column's
+    // row indices must be in range and increasing
+    auto check_matrix = [&](Array outer, int64_t rows, int64_t cols) {
+        const StorageIndex* outer_index = data<StorageIndex>(outer);
+        const StorageIndex* inner_index = data<StorageIndex>(static_cast<Array>(outer + 1));
+        for (int64_t col = 0; col < cols; ++col) {
+            if (outer_index[col + 1] < outer_index[col]) fail("matrix offsets decrease");
+        }
+        for (int64_t col = 0; col < cols; ++col) {
+            for (StorageIndex k = outer_index[col]; k < outer_index[col + 1]; ++k) {
+                if (inner_index[k] < 0 || inner_index[k] >= rows) fail("matrix row index out of range");
+                if (k > outer_index[col] && inner_index[k] <= inner_index[k - 1]) fail("matrix row indices not sorted");
+            }
+        }
+    };
+    check_matrix(kAEqOuter, eq_rows_, eq_cols_);
+    check_matrix(kAIneqOuter, ineq_rows_, ineq_cols_);
+
+    const uint64_t* name_offsets = data<uint64_t>(kNameOffsets);
+    for (uint64_t i = 1; i < lengths_[kNameOffsets]; ++i) {
+        if (name_offsets[i] < name_offsets[i - 1]) fail("name offsets decrease");
+    }
+}
+
+LpSnapshot::VectorView LpSnapshot::vector(Array array) const {
+    return VectorView(data<double>(array), static_cast<Eigen::Index>(lengths_[array]));
+}
+
+LpSnapshot::SparseView LpSnapshot::matrix(Array outer) const {
+    const bool eq = outer == kAEqOuter;
+    return SparseView(eq ? eq_rows_ : ineq_rows_, eq ? eq_cols_ : ineq_cols_,
+                      static_cast<Eigen::Index>(lengths_[outer + 1]), data<StorageIndex>(outer),
+                      data<StorageIndex>(static_cast<Array>(outer + 1)), data<double>(static_cast<Array>(outer + 2)));
+}
+
+std::string_view LpSnapshot::get_col_name(int col) const {
+    if (col < 0 || static_cast<uint64_t>(col) + 1 >= lengths_[kNameOffsets]) {
+        throw std::out_of_range("Column index out of range: " + std::to_string(col));
+    }
+    // Checked per name, so an unvalidated table cannot send the view outside the blob
+    const uint64_t* offsets = data<uint64_t>(kNameOffsets);
+    if (offsets[col] > offsets[col + 1] || offsets[col + 1] > lengths_[kNameChars]) {
+        throw std::runtime_error("Invalid LP snapshot " + path_ + ": name offsets decrease");
+    }
+    return std::string_view(data<char>(kNameChars) + offsets[col], offsets[col + 1] - offsets[col]);
+}
+
+std::unique_ptr<LpData> LpSnapshot::to_lp_data() const {
+    validate();  // the copy reads every index anyway
+    std::vector<std::string> col_names;
+    col_names.reserve(lengths_[kNameOffsets] - 1);
+    for (uint64_t i = 0; i + 1 < lengths_[kNameOffsets]; ++i) {
+        col_names.emplace_back(get_col_name(static_cast<int>(i)));
+    }
+    std::pair<Eigen::VectorXd, Eigen::VectorXd> bounds{get_lb(), get_ub()};
+    Eigen::SparseMatrix<double> A_eq = get_A_eq();
+    Eigen::SparseMatrix<double> A_ineq = get_A_ineq();
+    return std::make_unique<LpData>(n_vars_, Eigen::VectorXd(get_c()), std::move(bounds), std::move(A_eq),
+                                    Eigen::VectorXd(get_b_eq()), std::move(A_ineq), Eigen::VectorXd(get_b_ineq()),
+                                    obj_offset_, std::move(col_names), parse_time_seconds_);
+}
+
+} // namespace mps
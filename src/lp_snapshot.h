@@ -0,0 +1,106 @@
+#ifndef LP_SNAPSHOT_H
+#define LP_SNAPSHOT_H
+
+#include "lp_data.h"
+#include "mapped_file.h"
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace mps {
+
+// File name of the snapshot inside an instance directory written by save_lp_to_parquet
+inline constexpr const char* kSnapshotFileName = "lp_data.snap";
+
+/**
+ * Writes LpData as a native binary snapshot: a versioned header followed by 64-byte
+ * aligned arrays (dense vectors, the CSC arrays of A_eq and A_ineq, and a packed
+ * column name table) in this machine's byte order. Not an interchange format: it is
+ * read back by LpSnapshot on the same platform, for repeated runs over the same model.
+ * @param lp_data Model to write (uncompressed matrices are written compressed)
+ * @param path Output file
+ * @return Bytes written
+ * @throws std::runtime_error if the file cannot be written
+ */
+uint64_t save_lp_snapshot(const LpData& lp_data, const std::string& path);
+
+/**
+ * Read-only view of a snapshot written by save_lp_snapshot. The file is memory-mapped
+ * and the getters return Eigen::Map views straight into the mapping. Opening only reads
+ * the header and the ends of the offset arrays, so it takes the same time for any model;
+ * the arrays are paged in when first touched. validate() checks every index for files
+ * that may have been damaged or crafted.
+ * Views must not outlive the LpSnapshot.
+ */
+class LpSnapshot {
+public:
+    using SparseView = Eigen::Map<const Eigen::SparseMatrix<double>>;
+    using VectorView = Eigen::Map<const Eigen::VectorXd>;
+
+    /**
+     * Maps a snapshot and checks its header in constant time.
+     * @param path Snapshot file
+     * @throws std::runtime_error if the file cannot be mapped, was written by another
+     *         snapshot version or platform, is truncated, or its array lengths, shapes and
+     *         first and last offsets disagree
+     */
+    explicit LpSnapshot(const std::string& path);
+
+    /**
+     * Checks every matrix offset, row index and name offset, in one pass over the index
+     * arrays. Call it before using the matrix views of a file that was not written by
+     * save_lp_snapshot on a trusted path; to_lp_data() calls it.
+     * @throws std::runtime_error if offsets decrease or row indices are out of range or unsorted
+     */
+    void validate() const;
+
+    int get_n_vars() const { return n_vars_; }
+    VectorView get_c() const { return vector(kC); }
+    VectorView get_lb() const { return vector(kLb); }
+    VectorView get_ub() const { return vector(kUb); }
+    SparseView get_A_eq() const { return matrix(kAEqOuter); }
+    VectorView get_b_eq() const { return vector(kBEq); }
+    SparseView get_A_ineq() const { return matrix(kAIneqOuter); }
+    VectorView get_b_ineq() const { return vector(kBIneq); }
+    double get_obj_offset() const { return obj_offset_; }
+    double get_parse_time_seconds() const { return parse_time_seconds_; }
+    std::string_view get_col_name(int col) const;
+
+    // Copies the model into an owning LpData
+    std::unique_ptr<LpData> to_lp_data() const;
+
+    // Arrays of the file, in file order
+    enum Array {
+        kC, kLb, kUb, kBEq, kBIneq,
+        kAEqOuter, kAEqInner, kAEqValues,
+        kAIneqOuter, kAIneqInner, kAIneqValues,
+        kNameOffsets, kNameChars,
+        kArrayCount
+    };
+
+private:
+    VectorView vector(Array array) const;
+    // The three CSC arrays starting at outer
+    SparseView matrix(Array outer) const;
+
+    template <typename T>
+    const T* data(Array array) const {
+        return reinterpret_cast<const T*>(file_.data() + offsets_[array]);
+    }
+
+    MappedFile file_;
+    std::string path_;
+    int n_vars_ = 0;
+    int64_t eq_rows_ = 0, eq_cols_ = 0;
+    int64_t ineq_rows_ = 0, ineq_cols_ = 0;
+    double obj_offset_ = 0.0;
+    double parse_time_seconds_ = 0.0;
+    uint64_t offsets_[kArrayCount] = {};
+    uint64_t lengths_[kArrayCount] = {};  // elements, not bytes
+};
+
+} // namespace mps
+
+#endif // LP_SNAPSHOT_H
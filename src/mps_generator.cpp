@@ -0,0 +1,295 @@
+#include "mps_generator.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace mps {
+
+namespace {
+
+constexpr size_t kFlushBytes = 1 << 20;
+
+// Accumulates output in a string and hands it to the stream in 1 MiB pieces
+class MpsWriter {
+public:
+    explicit MpsWriter(std::ostream& out) : out_(out) { buffer_.reserve(kFlushBytes + 256); }
+
+    void text(std::string_view s) { buffer_.append(s); }
+
+    // Field separator wide enough to keep columns readable
+    void field(std::string_view s) {
+        buffer_.append("  ");
+        buffer_.append(s);
+    }
+
+    void number(double value) {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        field(std::string_view(digits, result.ptr - digits));
+    }
+
+    void end_line() {
+        buffer_.push_back('\n');
+        ++stats_.lines;
+        if (buffer_.size() >= kFlushBytes) flush();
+    }
+
+    MpsGeneratorStats& stats() { return stats_; }
+
+    void flush() {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!out_) {
+            throw std::runtime_error("Failed to write MPS output");
+        }
+        stats_.bytes += buffer_.size();
+        buffer_.clear();
+    }
+
+private:
+    std::ostream& out_;
+    std::string buffer_;
+    MpsGeneratorStats stats_;
+};
+
+// Names like R00000042: a prefix and a zero-padded index, name_length characters in total
+class NameFormat {
+public:
+    NameFormat(char prefix, int64_t count, int name_length) : prefix_(prefix) {
+        int digits = 1;
+        for (int64_t n = std::max<int64_t>(count - 1, 0); n >= 10; n /= 10) ++digits;
+        width_ = std::max(digits, name_length - 1);
+    }
+
+    std::string_view operator()(int64_t index) {
+        name_.assign(1, prefix_);
+        char digits[24];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), index);
+        name_.append(width_ - (result.ptr - digits), '0');
+        name_.append(digits, result.ptr);
+        return name_;
+    }
+
+private:
+    char prefix_;
+    int width_;
+    std::string name_;
+};
+
+// Mostly small integers, like the coefficients of most MIPLIB rows, plus some fractions
+double draw_coefficient(std::mt19937_64& rng) {
+    std::uniform_int_distribution<int> magnitude(1, 20);
+    std::uniform_int_distribution<int> kind(0, 9);
+    const int k = kind(rng);
+    const double value = k == 0 ? magnitude(rng) * 0.25 : magnitude(rng);
+    return k % 2 == 0 ? value : -value;
+}
+
+// k distinct rows in increasing order
+void draw_rows(std::mt19937_64& rng, int64_t n_rows, int64_t k, std::vector<int64_t>& rows) {
+    rows.clear();
+    if (k * 4 > n_rows) {
+        // Selection sampling: one pass over the rows, exactly k picked
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        for (int64_t row = 0; row < n_rows && static_cast<int64_t>(rows.size()) < k; ++row) {
+            if (unit(rng) * (n_rows - row) < k - static_cast<int64_t>(rows.size())) {
+                rows.push_back(row);
+            }
+        }
+        return;
+    }
+    std::uniform_int_distribution<int64_t> pick(0, n_rows - 1);
+    while (static_cast<int64_t>(rows.size()) < k) {
+        for (int64_t i = rows.size(); i < k; ++i) rows.push_back(pick(rng));
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    }
+}
+
+void validate(const MpsGeneratorOptions& options) {
+    auto fraction = [](double value, const char* what) {
+        if (!(value >= 0.0 && value <= 1.0)) {
+            throw std::invalid_argument(std::string(what) + " must be between 0 and 1");
+        }
+    };
+    if (options.rows < 0 || options.columns < 1) {
+        throw std::invalid_argument("A model needs at least one column and no negative row count");
+    }
+    fraction(options.density, "density");
+    fraction(options.objective_density, "objective density");
+    fraction(options.rhs_density, "RHS density");
+    fraction(options.range_density, "range density");
+    fraction(options.bound_density, "bound density");
+    fraction(options.integer_fraction, "integer fraction");
+    if (options.eq_weight < 0 || options.le_weight < 0 || options.ge_weight < 0 ||
+        options.eq_weight + options.le_weight + options.ge_weight <= 0) {
+        throw std::invalid_argument("Row type weights must be non-negative with a positive sum");
+    }
+    if (options.marker_block < 1) {
+        throw std::invalid_argument("MARKER blocks need at least one column");
+    }
+    if (options.name_length < 1) {
+        throw std::invalid_argument("Names need at least one character");
+    }
+    if (options.pairs_per_line != 1 && options.pairs_per_line != 2) {
+        throw std::invalid_argument("pairs per line must be 1 or 2");
+    }
+}
+
+} // namespace
+
+MpsGeneratorStats generate_mps(std::ostream& out, const MpsGeneratorOptions& options) {
+    validate(options);
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    MpsWriter writer(out);
+    NameFormat row_name('R', options.rows, options.name_length);
+    NameFormat col_name('C', options.columns, options.name_length);
+    const std::string_view objective = "COST";
+
+    writer.text("NAME");
+    writer.field(options.name);
+    writer.end_line();
+
+    // ROWS: types drawn by weight, the objective first
+    writer.text("ROWS");
+    writer.end_line();
+    writer.text(" N");
+    writer.field(objective);
+    writer.end_line();
+    std::discrete_distribution<int> row_type({options.eq_weight, options.le_weight, options.ge_weight});
+    const char* kTypes[] = {" E", " L", " G"};
+    for (int64_t i = 0; i < options.rows; ++i) {
+        writer.text(kTypes[row_type(rng)]);
+        writer.field(row_name(i));
+        writer.end_line();
+    }
+
+    // COLUMNS: one column at a time, integer blocks wrapped in MARKER lines
+    writer.text("COLUMNS");
+    writer.end_line();
+    std::binomial_distribution<int64_t> column_count(options.rows, options.density);
+    std::vector<int64_t> rows;
+    int64_t marker = 0;
+    bool in_integer_block = false;
+    for (int64_t j = 0; j < options.columns; ++j) {
+        if (j % options.marker_block == 0) {
+            const bool integer_block = unit(rng) < options.integer_fraction;
+            if (integer_block != in_integer_block) {
+                writer.text("    MARKER" + std::to_string(marker++));
+                writer.field("'MARKER'");
+                writer.field(integer_block ? "'INTORG'" : "'INTEND'");
+                writer.end_line();
+                in_integer_block = integer_block;
+            }
+        }
+
+        const std::string_view name = col_name(j);  // valid until the next column
+        int pending = 0;
+        auto entry = [&](std::string_view row, double value) {
+            if (pending == 0) {
+                writer.text("    ");
+                writer.text(name);
+            }
+            writer.field(row);
+            writer.number(value);
+            if (++pending == options.pairs_per_line) {
+                writer.end_line();
+                pending = 0;
+            }
+        };
+
+        if (unit(rng) < options.objective_density) {
+            entry(objective, draw_coefficient(rng));
+        }
+        draw_rows(rng, options.rows, options.rows > 0 ? column_count(rng) : 0, rows);
+        for (int64_t row : rows) {
+            entry(row_name(row), draw_coefficient(rng));
+        }
+        if (pending > 0) writer.end_line();
+        writer.stats().nonzeros += rows.size();
+    }
+    if (in_integer_block) {
+        writer.text("    MARKER" + std::to_string(marker));
+        writer.field("'MARKER'");
+        writer.field("'INTEND'");
+        writer.end_line();
+    }
+
+    // RHS and RANGES: sparse per-row values under one vector name
+    auto row_values = [&](const char* section, const char* vector_name, double density, bool positive) {
+        writer.text(section);
+        writer.end_line();
+        int pending = 0;
+        for (int64_t i = 0; i < options.rows; ++i) {
+            if (unit(rng) >= density) continue;
+            if (pending == 0) {
+                writer.text("    ");
+                writer.text(vector_name);
+            }
+            writer.field(row_name(i));
+            const double value = draw_coefficient(rng) * 5;
+            writer.number(positive ? std::abs(value) : value);
+            if (++pending == options.pairs_per_line) {
+                writer.end_line();
+                pending = 0;
+            }
+        }
+        if (pending > 0) writer.end_line();
+    };
+    row_values("RHS", "RHS", options.rhs_density, false);
+    if (options.range_density > 0) {
+        row_values("RANGES", "RNG", options.range_density, true);
+    }
+
+    // BOUNDS: a mix of the common bound types
+    if (options.bound_density > 0) {
+        writer.text("BOUNDS");
+        writer.end_line();
+        std::uniform_int_distribution<int> bound_kind(0, 9);
+        for (int64_t j = 0; j < options.columns; ++j) {
+            if (unit(rng) >= options.bound_density) continue;
+            const int kind = bound_kind(rng);
+            const double value = std::abs(draw_coefficient(rng)) * 10;
+            if (kind < 5) {
+                writer.text(" UP");
+            } else if (kind < 7) {
+                writer.text(" LO");
+            } else if (kind == 7) {
+                writer.text(" FX");
+            } else if (kind == 8) {
+                writer.text(" MI");
+            } else {
+                writer.text(" FR");
+            }
+            writer.field("BND");
+            writer.field(col_name(j));
+            if (kind < 8) writer.number(kind == 6 ? -value : value);
+            writer.end_line();
+        }
+    }
+
+    writer.text("ENDATA");
+    writer.end_line();
+    writer.flush();
+    return writer.stats();
+}
+
+MpsGeneratorStats generate_mps_file(const std::string& path, const MpsGeneratorOptions& options) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open output file: " + path);
+    }
+    MpsGeneratorStats stats = generate_mps(out, options);
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+    return stats;
+}
+
+} // namespace mps
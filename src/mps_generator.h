@@ -0,0 +1,57 @@
+#ifndef MPS_GENERATOR_H
+#define MPS_GENERATOR_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace mps {
+
+// Shape of a synthetic MPS model
+struct MpsGeneratorOptions {
+    int64_t rows = 1000;           // constraint rows (the objective row comes on top)
+    int64_t columns = 1000;
+    double density = 0.01;         // expected fraction of rows with a coefficient in each column
+    double eq_weight = 1.0;        // relative shares of E, L and G rows
+    double le_weight = 2.0;
+    double ge_weight = 1.0;
+    double objective_density = 1.0;  // fraction of columns with an objective coefficient
+    double rhs_density = 0.5;        // fraction of rows with a nonzero right-hand side
+    double range_density = 0.0;      // fraction of rows listed in RANGES
+    double bound_density = 0.3;      // fraction of columns listed in BOUNDS
+    double integer_fraction = 0.0;   // fraction of columns inside MARKER INTORG/INTEND blocks
+    int64_t marker_block = 100;      // columns per integer block
+    int name_length = 8;             // row and column name length (at least the digits needed)
+    int pairs_per_line = 2;          // row/value pairs per COLUMNS and RHS line (1 or 2)
+    uint64_t seed = 42;
+    std::string name = "SYNTH";
+};
+
+// Sizes of a generated model, as written
+struct MpsGeneratorStats {
+    int64_t nonzeros = 0;  // constraint coefficients (objective excluded)
+    int64_t lines = 0;
+    int64_t bytes = 0;
+};
+
+/**
+ * Writes a valid free-format MPS model with the given shape. Columns are generated
+ * and written one at a time, so memory stays at O(rows) whatever the file size.
+ * The same options and seed always produce the same file.
+ * @param out Destination stream
+ * @param options Model shape
+ * @return Counts of what was written
+ * @throws std::invalid_argument if the options are out of range
+ * @throws std::runtime_error if writing fails
+ */
+MpsGeneratorStats generate_mps(std::ostream& out, const MpsGeneratorOptions& options);
+
+/**
+ * Writes a synthetic model to a file through a large output buffer.
+ * @throws std::runtime_error if the file cannot be written
+ */
+MpsGeneratorStats generate_mps_file(const std::string& path, const MpsGeneratorOptions& options);
+
+} // namespace mps
+
+#endif // MPS_GENERATOR_H
@@ -1,50 +1,162 @@
 #include "mps_parser.h"
+#include "compressed_input.h"
+#include "log.h"
+#include "mapped_file.h"
+#include "mps_tokenizer.h"
+#include "number_parser.h"
+#include "parallel_columns.h"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
 #include <limits>
-#include <iostream>
 #include <chrono>
 
 namespace mps {
 
-ParserState::ParserState() = default;
+namespace {
+
+// First block of the parser arena; later blocks grow geometrically
+constexpr size_t kArenaInitialBytes = 1 << 16;
+
+} // namespace
+
+ParserState::ParserState(std::pmr::memory_resource* resource)
+    : counting_(resource ? resource : std::pmr::new_delete_resource()),
+      arena_(kArenaInitialBytes, &counting_),
+      resource_(resource ? static_cast<std::pmr::memory_resource*>(&counting_) : &arena_),
+      row_ids_(resource_),
+      col_ids_(resource_),
+      row_types_(resource_),
+      rhs_values_(resource_),
+      objective_(resource_),
+      bounds_(resource_),
+      col_start_(1, 0, resource_),
+      entry_rows_(resource_),
+      entry_values_(resource_),
+      out_of_order_entries_(resource_),
+      row_last_col_(resource_),
+      row_last_entry_(resource_) {}
+
 ParserState::~ParserState() = default;
 
-void ParserState::add_row(const std::string& name, char type) {
-    row_names_.push_back(name);
-    row_types_[name] = type;
+std::vector<std::string> ParserState::copy_col_names() const {
+    std::vector<std::string> names;
+    names.reserve(col_ids_.size());
+    for (int col = 0; col < col_ids_.size(); ++col) {
+        names.emplace_back(col_ids_.name(col));
+    }
+    return names;
+}
+
+void ParserState::add_row(std::string_view name, char type) {
+    const int n_rows = row_ids_.size();
+    const int id = row_ids_.intern(name);
+    if (id == n_rows) {
+        row_types_.push_back(type);
+        rhs_values_.push_back(0.0);
+        row_last_col_.push_back(-1);
+        row_last_entry_.push_back(0);
+    } else {
+        row_types_[id] = type;
+    }
     if (type == 'N') {
-        objective_name_ = name;
+        objective_name_ = row_ids_.name(id);
+        objective_row_ = id;
     }
 }
 
-void ParserState::add_column_coefficient(const std::string& col_name, const std::string& row_name, double value) {
-    // Check if column is new and add it to names and index map
-    if (col_name_to_index_.find(col_name) == col_name_to_index_.end()) {
-        int new_index = col_names_.size();
-        col_names_.push_back(col_name);
-        col_name_to_index_[col_name] = new_index;
+void ParserState::reserve(const MpsSizeHints& sizes) {
+    row_ids_.reserve(sizes.rows);
+    row_types_.reserve(sizes.rows);
+    rhs_values_.reserve(sizes.rows);
+    row_last_col_.reserve(sizes.rows);
+    row_last_entry_.reserve(sizes.rows);
+
+    col_ids_.reserve(sizes.columns);
+    objective_.reserve(sizes.columns);
+    bounds_.reserve(sizes.columns);
+    col_start_.reserve(sizes.columns + 1);
+
+    if (!sink_) {
+        entry_rows_.reserve(sizes.nonzeros);
+        entry_values_.reserve(sizes.nonzeros);
     }
+}
+
+void ParserState::set_objective_name(const std::string& name) {
+    objective_name_ = name;
+    objective_row_ = row_ids_.find(name);
+}
+
+void ParserState::add_column_coefficient(std::string_view col_name, std::string_view row_name, double value) {
+    const int col = add_column(col_name);
+
+    // Coefficients of rows missing from ROWS never reach the matrices
+    const int row = find_row(row_name);
+    if (row < 0) return;
 
-    if (row_name == objective_name_) {
-        objective_[col_name] = value;
+    add_coefficient(col, row, value);
+}
+
+int ParserState::add_column(std::string_view col_name) {
+    // Check if column is new and give it the next index
+    const int n_cols = col_ids_.size();
+    const int col = col_ids_.intern(col_name);
+    if (col == n_cols) {
+        if (sink_) send_column(n_cols - 1);
+        objective_.push_back(0.0);
+        bounds_.emplace_back(0.0, std::numeric_limits<double>::infinity());
+        col_start_.push_back(col_start_.back());
+    }
+    return col;
+}
+
+void ParserState::add_coefficient(int col, int row, double value) {
+    if (row == objective_row_) {
+        objective_[col] = value;
+    } else if (col + 1 == col_ids_.size()) {
+        // Newest column: append in place, a repeated row overwrites its earlier value
+        if (row_last_col_[row] == col) {
+            entry_values_[row_last_entry_[row]] = value;
+        } else {
+            row_last_col_[row] = col;
+            row_last_entry_[row] = entry_rows_.size();
+            entry_rows_.push_back(row);
+            entry_values_.push_back(value);
+            if (!sink_) ++col_start_.back();
+        }
+    } else if (sink_) {
+        sink_->add_column(*this, col, &row, &value, 1);
     } else {
-        constraints_[row_name][col_name] = value;
+        out_of_order_entries_.emplace_back(row, col, value);
     }
 }
 
-void ParserState::add_rhs_value(const std::string& row_name, double value) {
-    rhs_values_[row_name] = value;
+void ParserState::flush_coefficients() {
+    if (sink_) send_column(col_ids_.size() - 1);
+}
+
+void ParserState::send_column(int col) {
+    if (entry_rows_.empty()) return;
+    sink_->add_column(*this, col, entry_rows_.data(), entry_values_.data(), entry_rows_.size());
+    entry_rows_.clear();
+    entry_values_.clear();
 }
 
-void ParserState::add_bound(const std::string& type, const std::string& col_name, double value) {
-    if (bounds_.find(col_name) == bounds_.end()) {
-        bounds_[col_name] = {0.0, std::numeric_limits<double>::infinity()};
+void ParserState::add_rhs_value(std::string_view row_name, double value) {
+    const int row = row_ids_.find(row_name);
+    if (row >= 0) {
+        rhs_values_[row] = value;
     }
+}
+
+void ParserState::add_bound(std::string_view type, std::string_view col_name, double value) {
+    // Bounds on columns missing from COLUMNS never reach the model
+    const int col = col_ids_.find(col_name);
+    if (col < 0) return;
 
-    auto& bound = bounds_[col_name];
+    auto& bound = bounds_[col];
     if (type == "LO") {
         bound.first = value;
     } else if (type == "UP") {
@@ -65,130 +177,247 @@ void ParserState::add_bound(const std::string& type, const std::string& col_name
 }
 
 void ParserState::set_default_bounds() {
-    for (const auto& col : col_names_) {
-        if (bounds_.find(col) == bounds_.end()) {
-            bounds_[col] = {0.0, std::numeric_limits<double>::infinity()};
-        }
-    }
+    // Every column gets (0, +inf) when it is first seen; only fill any gap here
+    bounds_.resize(col_ids_.size(), {0.0, std::numeric_limits<double>::infinity()});
 }
 
 std::pair<Eigen::VectorXd, Eigen::VectorXd> ParserState::create_bounds() const {
-    const int n_vars = col_names_.size();
+    const int n_vars = col_ids_.size();
     Eigen::VectorXd lb = Eigen::VectorXd::Zero(n_vars);
     Eigen::VectorXd ub = Eigen::VectorXd::Constant(n_vars, std::numeric_limits<double>::infinity());
 
-    for (int i = 0; i < n_vars; ++i) {
-        const auto& col = col_names_[i];
-        if (bounds_.find(col) != bounds_.end()) {
-            const auto& bound = bounds_.at(col);
-            lb(i) = bound.first;
-            ub(i) = bound.second;
-        }
+    for (int i = 0; i < n_vars && i < static_cast<int>(bounds_.size()); ++i) {
+        lb(i) = bounds_[i].first;
+        ub(i) = bounds_[i].second;
     }
 
     return {lb, ub};
 }
 
+ParserState::ColumnEntries ParserState::merge_out_of_order_entries() const {
+    const int n_cols = col_ids_.size();
+    ColumnEntries merged;
+
+    // Counting sort by column: in-place entries first, then out-of-order ones in input order
+    merged.col_start.assign(n_cols + 1, 0);
+    for (int col = 0; col < n_cols; ++col) {
+        merged.col_start[col + 1] = col_start_[col + 1] - col_start_[col];
+    }
+    for (const auto& entry : out_of_order_entries_) {
+        ++merged.col_start[entry.col() + 1];
+    }
+    for (int col = 0; col < n_cols; ++col) {
+        merged.col_start[col + 1] += merged.col_start[col];
+    }
+
+    std::vector<int> rows(merged.col_start.back());
+    std::vector<double> values(merged.col_start.back());
+    std::vector<int> next(merged.col_start.begin(), merged.col_start.end() - 1);
+    for (int col = 0; col < n_cols; ++col) {
+        for (int k = col_start_[col]; k < col_start_[col + 1]; ++k) {
+            rows[next[col]] = entry_rows_[k];
+            values[next[col]++] = entry_values_[k];
+        }
+    }
+    for (const auto& entry : out_of_order_entries_) {
+        rows[next[entry.col()]] = entry.row();
+        values[next[entry.col()]++] = entry.value();
+    }
+
+    // Drop repeated rows within a column, keeping the last value
+    std::vector<int> row_seen_in(row_ids_.size(), -1);
+    merged.rows.reserve(rows.size());
+    merged.values.reserve(values.size());
+    for (int col = 0; col < n_cols; ++col) {
+        const int begin = merged.col_start[col];
+        const int end = merged.col_start[col + 1];
+        merged.col_start[col] = merged.rows.size();
+        for (int k = end - 1; k >= begin; --k) {
+            if (row_seen_in[rows[k]] == col) continue;
+            row_seen_in[rows[k]] = col;
+            merged.rows.push_back(rows[k]);
+            merged.values.push_back(values[k]);
+        }
+    }
+    merged.col_start[n_cols] = merged.rows.size();
+    return merged;
+}
+
+namespace {
+
+// Sorts one column of compressed storage by row index (rows are already unique)
+void sort_column(int* inner, double* values, int count, std::vector<std::pair<int, double>>& scratch) {
+    if (std::is_sorted(inner, inner + count)) return;
+    scratch.clear();
+    for (int k = 0; k < count; ++k) {
+        scratch.emplace_back(inner[k], values[k]);
+    }
+    std::sort(scratch.begin(), scratch.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (int k = 0; k < count; ++k) {
+        inner[k] = scratch[k].first;
+        values[k] = scratch[k].second;
+    }
+}
+
+} // namespace
+
 void ParserState::build_matrices(int& n_vars,
                                Eigen::VectorXd& c,
                                Eigen::SparseMatrix<double>& A_eq,
                                Eigen::VectorXd& b_eq,
                                Eigen::SparseMatrix<double>& A_ineq,
-                               Eigen::VectorXd& b_ineq) const {
-    using Triplet = Eigen::Triplet<double>;
-    std::vector<Triplet> eq_triplets, ineq_triplets;
-    std::vector<double> eq_rhs, ineq_rhs;
+                               Eigen::VectorXd& b_ineq,
+                               MatrixAssembly assembly,
+                               double* assembly_seconds) const {
     std::vector<int> eq_indices, l_indices, g_indices;
 
     // Count constraints by type
-    for (size_t i = 0; i < row_names_.size(); ++i) {
-        const auto& row = row_names_[i];
-        if (row == objective_name_) continue;
+    for (int i = 0; i < row_ids_.size(); ++i) {
+        if (i == objective_row_) continue;
 
-        char type = row_types_.at(row);
+        char type = row_types_[i];
         if (type == 'E') eq_indices.push_back(i);
         else if (type == 'L') l_indices.push_back(i);
         else if (type == 'G') g_indices.push_back(i);
     }
 
+    // Row permutation: each row id maps to its position in A_eq or A_ineq (-1 = not a constraint).
+    // Inequalities keep all L rows first, then all G rows negated into <= form.
+    std::vector<int> row_position(row_ids_.size(), -1);
+    std::vector<char> row_is_eq(row_ids_.size(), 0);
+    std::vector<char> row_negated(row_ids_.size(), 0);
+    for (size_t i = 0; i < eq_indices.size(); ++i) {
+        row_position[eq_indices[i]] = i;
+        row_is_eq[eq_indices[i]] = 1;
+    }
+    for (size_t i = 0; i < l_indices.size(); ++i) {
+        row_position[l_indices[i]] = i;
+    }
+    for (size_t i = 0; i < g_indices.size(); ++i) {
+        row_position[g_indices[i]] = l_indices.size() + i;
+        row_negated[g_indices[i]] = 1;
+    }
+
     // Set dimensions
-    n_vars = col_names_.size();
+    n_vars = col_ids_.size();
     c = Eigen::VectorXd::Zero(n_vars);
 
     // Fill objective coefficients
-    for (const auto& [col, value] : objective_) {
-        // Use map for O(1) lookup
-        auto it = col_name_to_index_.find(col);
-        if (it != col_name_to_index_.end()) {
-            c(it->second) = value;
-        }
+    for (int i = 0; i < n_vars; ++i) {
+        c(i) = objective_[i];
     }
 
-    // Build equality constraints
-    if (!eq_indices.empty()) {
-        A_eq.resize(eq_indices.size(), n_vars);
-        b_eq.resize(eq_indices.size());
-
-        for (size_t i = 0; i < eq_indices.size(); ++i) {
-            const auto& row = row_names_[eq_indices[i]];
-            b_eq(i) = rhs_values_.count(row) ? rhs_values_.at(row) : 0.0;
-
-            if (constraints_.count(row)) {
-                for (const auto& [col, value] : constraints_.at(row)) {
-                    // Use map for O(1) lookup
-                    auto it = col_name_to_index_.find(col);
-                    if (it != col_name_to_index_.end()) {
-                        eq_triplets.emplace_back(i, it->second, value);
-                    }
-                }
-            }
-        }
-        A_eq.setFromTriplets(eq_triplets.begin(), eq_triplets.end());
+    // Column entries, merged only if some column was listed in more than one place
+    ColumnEntries merged;
+    if (!out_of_order_entries_.empty()) {
+        merged = merge_out_of_order_entries();
     }
+    const bool use_merged = !out_of_order_entries_.empty();
+    const int* col_start = use_merged ? merged.col_start.data() : col_start_.data();
+    const int* entry_rows = use_merged ? merged.rows.data() : entry_rows_.data();
+    const double* entry_values = use_merged ? merged.values.data() : entry_values_.data();
 
-    // Build inequality constraints
+    const size_t n_eq = eq_indices.size();
     const size_t n_ineq = l_indices.size() + g_indices.size();
-    if (n_ineq > 0) {
-        A_ineq.resize(n_ineq, n_vars);
-        b_ineq.resize(n_ineq);
-
-        size_t ineq_idx = 0;
-
-        // Process L constraints
-        for (int l_idx : l_indices) {
-            const auto& row = row_names_[l_idx];
-            b_ineq(ineq_idx) = rhs_values_.count(row) ? rhs_values_.at(row) : 0.0;
-
-            if (constraints_.count(row)) {
-                for (const auto& [col, value] : constraints_.at(row)) {
-                    // Use map for O(1) lookup
-                    auto it = col_name_to_index_.find(col);
-                    if (it != col_name_to_index_.end()) {
-                        ineq_triplets.emplace_back(ineq_idx, it->second, value);
-                    }
+    A_eq.resize(n_eq, n_vars);  // 0 x n_vars for a block without rows, as load_lp_from_parquet returns it
+    A_ineq.resize(n_ineq, n_vars);
+
+    if (assembly == MatrixAssembly::Triplets) {
+        using Triplet = Eigen::Triplet<double>;
+        size_t n_eq_entries = 0, n_ineq_entries = 0;
+        for (int k = 0; k < col_start[n_vars]; ++k) {
+            const int row = entry_rows[k];
+            if (row_position[row] < 0) continue;
+            ++(row_is_eq[row] ? n_eq_entries : n_ineq_entries);
+        }
+        std::vector<Triplet> eq_triplets, ineq_triplets;
+        eq_triplets.reserve(n_eq_entries);
+        ineq_triplets.reserve(n_ineq_entries);
+        for (int col = 0; col < n_vars; ++col) {
+            for (int k = col_start[col]; k < col_start[col + 1]; ++k) {
+                const int row = entry_rows[k];
+                const int position = row_position[row];
+                if (position < 0) continue;
+                if (row_is_eq[row]) {
+                    eq_triplets.emplace_back(position, col, entry_values[k]);
+                } else {
+                    ineq_triplets.emplace_back(position, col, row_negated[row] ? -entry_values[k] : entry_values[k]);
                 }
             }
-            ineq_idx++;
         }
-
-        // Process G constraints (convert to ≤ form by negating)
-        for (int g_idx : g_indices) {
-            const auto& row = row_names_[g_idx];
-            b_ineq(ineq_idx) = rhs_values_.count(row) ? -rhs_values_.at(row) : 0.0;
-
-            if (constraints_.count(row)) {
-                for (const auto& [col, value] : constraints_.at(row)) {
-                    // Use map for O(1) lookup
-                    auto it = col_name_to_index_.find(col);
-                    if (it != col_name_to_index_.end()) {
-                        ineq_triplets.emplace_back(ineq_idx, it->second, -value);
-                    }
+        const auto assembly_start = std::chrono::steady_clock::now();
+        if (n_eq > 0) A_eq.setFromTriplets(eq_triplets.begin(), eq_triplets.end());
+        if (n_ineq > 0) A_ineq.setFromTriplets(ineq_triplets.begin(), ineq_triplets.end());
+        if (assembly_seconds) {
+            *assembly_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - assembly_start).count();
+        }
+    } else {
+        const auto assembly_start = std::chrono::steady_clock::now();
+        // Count pass: nonzeros per column of each block, accumulated into the outer indices
+        using StorageIndex = Eigen::SparseMatrix<double>::StorageIndex;
+        StorageIndex* eq_outer = n_eq > 0 ? A_eq.outerIndexPtr() : nullptr;
+        StorageIndex* ineq_outer = n_ineq > 0 ? A_ineq.outerIndexPtr() : nullptr;
+        for (int col = 0; col < n_vars; ++col) {
+            for (int k = col_start[col]; k < col_start[col + 1]; ++k) {
+                const int row = entry_rows[k];
+                if (row_position[row] < 0) continue;
+                ++(row_is_eq[row] ? eq_outer : ineq_outer)[col + 1];
+            }
+        }
+        for (int col = 0; col < n_vars; ++col) {
+            if (eq_outer) eq_outer[col + 1] += eq_outer[col];
+            if (ineq_outer) ineq_outer[col + 1] += ineq_outer[col];
+        }
+        if (eq_outer) A_eq.resizeNonZeros(eq_outer[n_vars]);
+        if (ineq_outer) A_ineq.resizeNonZeros(ineq_outer[n_vars]);
+
+        // Fill pass: permute rows into place column by column; only within-column order needs fixing
+        std::vector<std::pair<int, double>> scratch;
+        StorageIndex eq_next = 0, ineq_next = 0;
+        for (int col = 0; col < n_vars; ++col) {
+            const StorageIndex eq_begin = eq_next, ineq_begin = ineq_next;
+            for (int k = col_start[col]; k < col_start[col + 1]; ++k) {
+                const int row = entry_rows[k];
+                const int position = row_position[row];
+                if (position < 0) continue;
+                if (row_is_eq[row]) {
+                    A_eq.innerIndexPtr()[eq_next] = position;
+                    A_eq.valuePtr()[eq_next++] = entry_values[k];
+                } else {
+                    A_ineq.innerIndexPtr()[ineq_next] = position;
+                    A_ineq.valuePtr()[ineq_next++] = row_negated[row] ? -entry_values[k] : entry_values[k];
                 }
             }
-            ineq_idx++;
+            if (eq_next > eq_begin) {
+                sort_column(A_eq.innerIndexPtr() + eq_begin, A_eq.valuePtr() + eq_begin, eq_next - eq_begin, scratch);
+            }
+            if (ineq_next > ineq_begin) {
+                sort_column(A_ineq.innerIndexPtr() + ineq_begin, A_ineq.valuePtr() + ineq_begin, ineq_next - ineq_begin, scratch);
+            }
         }
+        if (assembly_seconds) {
+            *assembly_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - assembly_start).count();
+        }
+    }
 
-        A_ineq.setFromTriplets(ineq_triplets.begin(), ineq_triplets.end());
+    // Right-hand sides
+    if (n_eq > 0) {
+        b_eq.resize(n_eq);
+        for (size_t i = 0; i < n_eq; ++i) {
+            b_eq(i) = rhs_values_[eq_indices[i]];
+        }
+    }
+    if (n_ineq > 0) {
+        b_ineq.resize(n_ineq);
+        for (size_t i = 0; i < l_indices.size(); ++i) {
+            b_ineq(i) = rhs_values_[l_indices[i]];
+        }
+        // G constraints are converted to <= form by negating (a missing RHS stays +0.0)
+        for (size_t i = 0; i < g_indices.size(); ++i) {
+            const double rhs = rhs_values_[g_indices[i]];
+            b_ineq(l_indices.size() + i) = rhs != 0.0 ? -rhs : 0.0;
+        }
     }
 }
 
@@ -211,10 +440,11 @@ void parse_columns_section(const std::string& line, ParserState& state) {
 
     if (col_name == "'MARKER'") return;
 
-    std::string row_name;
-    double value;
+    std::string row_name, value;
     while (iss >> row_name >> value) {
-        state.add_column_coefficient(col_name, row_name, value);
+        // Integrality markers: "MARKER 'MARKER' 'INTORG'"
+        if (row_name == "'MARKER'") return;
+        state.add_column_coefficient(col_name, row_name, parse_double(value));
     }
 }
 
@@ -223,10 +453,9 @@ void parse_rhs_section(const std::string& line, ParserState& state) {
     std::string rhs_name;  // Skip RHS name
     iss >> rhs_name;
 
-    std::string row_name;
-    double value;
+    std::string row_name, value;
     while (iss >> row_name >> value) {
-        state.add_rhs_value(row_name, value);
+        state.add_rhs_value(row_name, parse_double(value));
     }
 }
 
@@ -235,113 +464,400 @@ void parse_bounds_section(const std::string& line, ParserState& state) {
     std::string bound_type, bound_name, col_name;
     iss >> bound_type >> bound_name >> col_name;
 
+    double value = 0.0;
+    std::string value_str;
+    if (!(bound_type == "FR" || bound_type == "MI" || bound_type == "PL") && (iss >> value_str)) {
+        value = parse_double(value_str);
+    }
+
+    state.add_bound(bound_type, col_name, value);
+}
+
+void parse_rows_view(std::string_view line, ParserState& state) {
+    TokenCursor tokens(line);
+    std::string_view type_str, name;
+    tokens.next(type_str);
+    tokens.next(name);
+
+    if (type_str.length() != 1) {
+        throw std::runtime_error("Invalid row type: " + std::string(type_str));
+    }
+
+    state.add_row(name, type_str[0]);
+}
+
+void parse_columns_view(std::string_view line, ParserState& state) {
+    TokenCursor tokens(line);
+    std::string_view col_name, row_name, value;
+    tokens.next(col_name);
+
+    if (col_name == "'MARKER'") return;
+
+    while (tokens.next(row_name)) {
+        // Integrality markers: "MARKER 'MARKER' 'INTORG'"
+        if (row_name == "'MARKER'") return;
+        if (!tokens.next(value)) {
+            throw std::runtime_error("Missing value for row " + std::string(row_name));
+        }
+        state.add_column_coefficient(col_name, row_name, parse_double(value));
+    }
+}
+
+void parse_rhs_view(std::string_view line, ParserState& state) {
+    TokenCursor tokens(line);
+    std::string_view rhs_name, row_name, value;  // Skip RHS name
+    tokens.next(rhs_name);
+
+    while (tokens.next(row_name)) {
+        if (!tokens.next(value)) {
+            throw std::runtime_error("Missing value for row " + std::string(row_name));
+        }
+        state.add_rhs_value(row_name, parse_double(value));
+    }
+}
+
+void parse_bounds_view(std::string_view line, ParserState& state) {
+    TokenCursor tokens(line);
+    std::string_view bound_type, bound_name, col_name, value_str;
+    tokens.next(bound_type);
+    tokens.next(bound_name);
+    tokens.next(col_name);
+
     double value = 0.0;
     if (!(bound_type == "FR" || bound_type == "MI" || bound_type == "PL")) {
-        iss >> value;
+        if (tokens.next(value_str)) {
+            value = parse_double(value_str);
+        }
     }
 
     state.add_bound(bound_type, col_name, value);
 }
 
-std::unique_ptr<LpData> parse_mps(const std::string& path) {
-    const auto start_time = std::chrono::steady_clock::now();
-    std::cout << "Starting MPS parsing for file: " << path << std::endl;
+namespace {
 
-    ParserState state;
+void check_timeout(const std::chrono::steady_clock::time_point& start_time) {
+    auto current_time = std::chrono::steady_clock::now();
+    if (std::chrono::duration_cast<std::chrono::seconds>(
+            current_time - start_time) > TIMEOUT_SECONDS) {
+        throw std::runtime_error("MPS parsing exceeded timeout");
+    }
+}
+
+// Original reader: one heap string per line and one istringstream per section line
+void read_sections_stream(const std::string& path, ParserState& state,
+                          const std::chrono::steady_clock::time_point& start_time,
+                          MpsScanRecorder& scan) {
     std::string current_section;
-    double parse_time_seconds = 0.0;
-    int n_vars = 0;
-    Eigen::VectorXd c;
-    Eigen::SparseMatrix<double> A_eq, A_ineq;
-    Eigen::VectorXd b_eq, b_ineq;
-    std::pair<Eigen::VectorXd, Eigen::VectorXd> bounds;
-    double obj_offset = 0.0;
 
-    try {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + path);
+    auto input = open_mps_input(path);
+    std::istream& file = *input;
+
+    std::string line;
+    size_t line_num = 0;
+    size_t offset = 0;
+    while (std::getline(file, line)) {
+        const size_t line_offset = offset;
+        offset += line.size() + 1;
+
+        // Check timeout
+        if (line_num++ % 100 == 0) {
+            check_timeout(start_time);
         }
 
-        std::string line;
-        size_t line_num = 0;
-        while (std::getline(file, line)) {
-            // Check timeout
-            if (line_num++ % 100 == 0) {
-                auto current_time = std::chrono::steady_clock::now();
-                if (std::chrono::duration_cast<std::chrono::seconds>(
-                        current_time - start_time) > TIMEOUT_SECONDS) {
-                    throw std::runtime_error("MPS parsing exceeded timeout");
-                }
+        // Trim whitespace
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t") + 1);
+
+        if (line.empty() || line[0] == '*') continue;
+
+        // Check for section headers
+        if ((current_section.empty() && is_name_line(line)) || line == "ROWS" || line == "COLUMNS" ||
+            line == "RHS" || line == "RANGES" || line == "BOUNDS" || 
+            line == "ENDATA") {
+            if (line == "ENDATA") {
+                scan.endata(line_num, line_offset);
+                return;
+            }
+            scan.section(line, line_num, line_offset);
+            current_section = line.substr(0, 4) == "NAME" ? "NAME" : line;
+            if (line == "RANGES") {
+                log_message(LogLevel::Warning, "RANGES section is not currently handled");
             }
+            continue;
+        }
 
-            // Trim whitespace
-            line.erase(0, line.find_first_not_of(" \t"));
-            line.erase(line.find_last_not_of(" \t") + 1);
+        try {
+            if (current_section == "ROWS") {
+                parse_rows_section(line, state);
+            } else if (current_section == "COLUMNS") {
+                parse_columns_section(line, state);
+            } else if (current_section == "RHS") {
+                parse_rhs_section(line, state);
+            } else if (current_section == "BOUNDS") {
+                parse_bounds_section(line, state);
+            }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Error parsing line " + 
+                std::to_string(line_num) + " in section " + 
+                current_section + ": " + e.what());
+        }
+    }
+    scan.finish(line_num, offset);
+}
 
-            if (line.empty() || line[0] == '*') continue;
+enum class Section { None, Name, Rows, Columns, Rhs, Ranges, Bounds };
+
+// Returns true and sets section if the trimmed line is a section header; NAME only
+// counts while no section has started
+bool match_section_header(std::string_view line, Section& section) {
+    if (section == Section::None && is_name_line(line)) section = Section::Name;
+    else if (line == "ROWS") section = Section::Rows;
+    else if (line == "COLUMNS") section = Section::Columns;
+    else if (line == "RHS") section = Section::Rhs;
+    else if (line == "RANGES") section = Section::Ranges;
+    else if (line == "BOUNDS") section = Section::Bounds;
+    else return false;
+    return true;
+}
 
-            // Check for section headers
-            if (line == "NAME" || line == "ROWS" || line == "COLUMNS" || 
-                line == "RHS" || line == "RANGES" || line == "BOUNDS" || 
-                line == "ENDATA") {
-                if (line == "ENDATA") break;
-                current_section = line;
-                if (line == "RANGES") {
-                    std::cout << "Warning: RANGES section is not currently handled" << std::endl;
-                }
-                continue;
+// Returns the byte offset just past the section body starting at the reader's position,
+// counting its lines; the reader itself is left untouched
+size_t find_section_end(LineReader lines, size_t& line_count) {
+    Section section = Section::Columns;
+    std::string_view line;
+    size_t end = lines.position();
+    line_count = 0;
+    while (lines.next(line)) {
+        line = trim_view(line);
+        if (line == "ENDATA" || match_section_header(line, section)) break;
+        end = lines.position();
+        ++line_count;
+    }
+    return end;
+}
+
+// Line source over a sequential stream, with the same next() as LineReader.
+// Each view stays valid until the following call.
+class StreamLineReader {
+public:
+    explicit StreamLineReader(std::istream& input) : input_(input) {}
+
+    bool next(std::string_view& line) {
+        if (!std::getline(input_, buffer_)) return false;
+        line = buffer_;
+        position_ += buffer_.size() + 1;
+        return true;
+    }
+
+    // Bytes of text consumed so far, counting one per stripped '\n'
+    size_t position() const { return position_; }
+
+private:
+    std::istream& input_;
+    std::string buffer_;
+    size_t position_ = 0;
+};
+
+// Section loop shared by the mapped and the decompressing readers. on_columns_header is
+// called after a COLUMNS header; it may consume the whole section body (returning true
+// and advancing line_num past it) instead of leaving it to the line-by-line parsers.
+template <typename Lines, typename ColumnsHook>
+void read_sections_views(Lines& lines, ParserState& state,
+                         const std::chrono::steady_clock::time_point& start_time,
+                         MpsScanRecorder& scan, ColumnsHook on_columns_header) {
+    Section current_section = Section::None;
+    std::string_view section_name;
+    std::string_view line;
+    size_t line_num = 0;
+    size_t line_offset = lines.position();
+    for (; lines.next(line); line_offset = lines.position()) {
+        // Check timeout
+        if (line_num++ % 100 == 0) {
+            check_timeout(start_time);
+        }
+
+        line = trim_view(line);
+        if (line.empty() || line[0] == '*') continue;
+
+        // Check for section headers
+        if (line == "ENDATA") {
+            scan.endata(line_num, line_offset);
+            return;
+        }
+        if (match_section_header(line, current_section)) {
+            scan.section(line, line_num, line_offset);
+            section_name = line.substr(0, current_section == Section::Name ? 4 : line.size());
+            if (current_section == Section::Ranges) {
+                log_message(LogLevel::Warning, "RANGES section is not currently handled");
             }
+            if (current_section == Section::Columns && on_columns_header(line_num)) {
+                check_timeout(start_time);
+            }
+            continue;
+        }
 
-            try {
-                if (current_section == "ROWS") {
-                    parse_rows_section(line, state);
-                } else if (current_section == "COLUMNS") {
-                    parse_columns_section(line, state);
-                } else if (current_section == "RHS") {
-                    parse_rhs_section(line, state);
-                } else if (current_section == "BOUNDS") {
-                    parse_bounds_section(line, state);
-                }
-            } catch (const std::exception& e) {
-                throw std::runtime_error("Error parsing line " + 
-                    std::to_string(line_num) + " in section " + 
-                    current_section + ": " + e.what());
+        try {
+            switch (current_section) {
+                case Section::Rows: parse_rows_view(line, state); break;
+                case Section::Columns: parse_columns_view(line, state); break;
+                case Section::Rhs: parse_rhs_view(line, state); break;
+                case Section::Bounds: parse_bounds_view(line, state); break;
+                default: break;
             }
+        } catch (const std::exception& e) {
+            throw std::runtime_error("Error parsing line " +
+                std::to_string(line_num) + " in section " +
+                std::string(section_name) + ": " + e.what());
         }
+    }
+    scan.finish(line_num, lines.position());
+}
 
-        file.close();
+// Zero-copy reader: walks the mapped file with string_view lines and tokens
+void read_sections_mapped(const std::string& path, ParserState& state,
+                          const std::chrono::steady_clock::time_point& start_time,
+                          int num_threads, bool presize, MpsScanRecorder& scan) {
+    MappedFile file(path);
+    LineReader lines(file.view());
+    if (presize) {
+        state.reserve(prescan_mps_sizes(file.view()));
+    }
 
-        const auto end_read_time = std::chrono::steady_clock::now(); // Time after reading file
-        const double read_duration_sec = std::chrono::duration_cast<std::chrono::milliseconds>(end_read_time - start_time).count() / 1000.0;
-        std::cout << "Finished reading MPS sections in " << read_duration_sec << " seconds" << std::endl;
+    read_sections_views(lines, state, start_time, scan, [&](size_t& line_num) {
+        if (num_threads == 1) return false;
+        size_t body_lines = 0;
+        const size_t body_begin = lines.position();
+        const size_t body_end = find_section_end(lines, body_lines);
+        parse_columns_parallel(file.view().substr(body_begin, body_end - body_begin),
+                               line_num, state, num_threads);
+        lines.skip_to(body_end);
+        line_num += body_lines;
+        return true;
+    });
+}
 
-        // Post-processing and matrix construction
-        const auto start_post_proc_time = std::chrono::steady_clock::now();
-        state.set_default_bounds();
-        bounds = state.create_bounds();
-        const auto end_post_proc_time = std::chrono::steady_clock::now();
-        const double post_proc_duration_sec = std::chrono::duration_cast<std::chrono::microseconds>(end_post_proc_time - start_post_proc_time).count() / 1e6;
-        std::cout << "Post-processing (bounds) took: " << post_proc_duration_sec << " seconds" << std::endl;
+// Compressed input: the same view parsers over lines decoded by a background thread
+void read_sections_decompressed(const std::string& path, ParserState& state,
+                                const std::chrono::steady_clock::time_point& start_time,
+                                MpsScanRecorder& scan) {
+    auto input = open_mps_input(path);
+    StreamLineReader lines(*input);
+    read_sections_views(lines, state, start_time, scan, [](size_t&) { return false; });
+}
 
-        const auto start_build_matrices_time = std::chrono::steady_clock::now();
-        state.build_matrices(n_vars, c, A_eq, b_eq, A_ineq, b_ineq);
-        const auto end_build_matrices_time = std::chrono::steady_clock::now();
-        const double build_matrices_duration_sec = std::chrono::duration_cast<std::chrono::microseconds>(end_build_matrices_time - start_build_matrices_time).count() / 1e6;
-        std::cout << "Building matrices took: " << build_matrices_duration_sec << " seconds" << std::endl;
+} // namespace
+
+MpsSizeHints prescan_mps_sizes(std::string_view text) {
+    MpsSizeHints sizes;
+    LineReader lines(text);
+    Section current_section = Section::None;
+    std::string_view line, previous_column, field;
+    while (lines.next(line)) {
+        line = trim_view(line);
+        if (line.empty() || line[0] == '*') continue;
+        if (line == "ENDATA") break;
+        const bool in_columns = current_section == Section::Columns;
+        if (match_section_header(line, current_section)) {
+            if (in_columns) break;  // nothing after COLUMNS is counted
+            continue;
+        }
 
-    } catch (const std::exception& e) {
-        std::cout << "Error: " << e.what() << std::endl;
-        throw;
+        if (current_section == Section::Rows) {
+            ++sizes.rows;
+        } else if (in_columns) {
+            TokenCursor tokens(line);
+            std::string_view column;
+            tokens.next(column);
+            size_t n_fields = 0;
+            bool marker = column == "'MARKER'";
+            while (!marker && tokens.next(field)) {
+                marker = field == "'MARKER'";
+                ++n_fields;
+            }
+            if (marker) continue;
+            if (column != previous_column) {
+                ++sizes.columns;
+                previous_column = column;
+            }
+            sizes.nonzeros += n_fields / 2;
+        }
+    }
+    return sizes;
+}
+
+std::unique_ptr<LpData> parse_mps(const std::string& path, const ParseOptions& options) {
+    MpsScan scan;
+    return parse_mps(path, options, scan);
+}
+
+std::unique_ptr<LpData> parse_mps(const std::string& path, const ParseOptions& options, MpsScan& scan) {
+    const auto start_time = std::chrono::steady_clock::now();
+    log_message(LogLevel::Debug, "Starting MPS parsing for file: ", path);
+
+    auto state = std::make_unique<ParserState>(options.memory_resource);
+    state->set_coefficient_sink(options.coefficient_sink);
+    double parse_time_seconds = 0.0;
+    int n_vars = 0;
+    Eigen::VectorXd c;
+    Eigen::SparseMatrix<double> A_eq, A_ineq;
+    Eigen::VectorXd b_eq, b_ineq;
+    std::pair<Eigen::VectorXd, Eigen::VectorXd> bounds;
+    double obj_offset = 0.0;
+    std::vector<std::string> col_names;
+    ParseStats stats;
+    scan = MpsScan();
+    MpsScanRecorder recorder(scan);
+
+    if (options.backend == ReaderBackend::Stream) {
+        read_sections_stream(path, *state, start_time, recorder);
+    } else if (detect_compression(path) != Compression::None) {
+        // A compressed file cannot be mapped as text; decode it while parsing instead
+        read_sections_decompressed(path, *state, start_time, recorder);
+    } else {
+        read_sections_mapped(path, *state, start_time, options.num_threads, options.presize, recorder);
     }
 
+    state->flush_coefficients();
+    const auto end_read_time = std::chrono::steady_clock::now(); // Time after reading file
+    stats.read_seconds = std::chrono::duration<double>(end_read_time - start_time).count();
+    log_message(LogLevel::Debug, "Finished reading MPS sections in ", stats.read_seconds, " seconds");
+
+    // Post-processing and matrix construction
+    const auto start_post_proc_time = std::chrono::steady_clock::now();
+    state->set_default_bounds();
+    bounds = state->create_bounds();
+    const auto end_post_proc_time = std::chrono::steady_clock::now();
+    stats.bounds_seconds = std::chrono::duration<double>(end_post_proc_time - start_post_proc_time).count();
+    log_message(LogLevel::Debug, "Post-processing (bounds) took: ", stats.bounds_seconds, " seconds");
+
+    const auto start_build_matrices_time = std::chrono::steady_clock::now();
+    state->build_matrices(n_vars, c, A_eq, b_eq, A_ineq, b_ineq, options.assembly, &stats.assembly_seconds);
+    const auto end_build_matrices_time = std::chrono::steady_clock::now();
+    stats.build_matrices_seconds = std::chrono::duration<double>(end_build_matrices_time - start_build_matrices_time).count();
+    log_message(LogLevel::Debug, "Building matrices took: ", stats.build_matrices_seconds, " seconds");
+
+    // Free the parse buffers before the model is handed over
+    col_names = state->copy_col_names();
+    stats.parser_memory = state->get_allocation_stats();
+    log_message(LogLevel::Debug, "Parser memory: ", stats.parser_memory.allocations, " allocations, ",
+                stats.parser_memory.bytes, " bytes");
+    state.reset();
+
     const auto end_time = std::chrono::steady_clock::now();
     const auto parse_duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
     parse_time_seconds = parse_duration.count() / 1e6;
-
-    std::cout << "Total parsing time: " << parse_time_seconds << " seconds" << std::endl;
-
-    return std::make_unique<LpData>(n_vars, c, bounds, A_eq, b_eq, A_ineq, b_ineq, obj_offset, state.get_col_names(), parse_time_seconds);
+    stats.total_seconds = parse_time_seconds;
+    stats.process_peak_rss_bytes = peak_rss_bytes();
+    stats.scan = scan;
+
+    log_message(LogLevel::Debug, "Total parsing time: ", parse_time_seconds, " seconds");
+
+    // The model buffers are moved into LpData, so only one copy of the model ever exists
+    auto lp = std::make_unique<LpData>(n_vars, std::move(c), std::move(bounds), std::move(A_eq), std::move(b_eq),
+                                       std::move(A_ineq), std::move(b_ineq), obj_offset, std::move(col_names),
+                                       parse_time_seconds);
+    lp->set_parse_stats(std::move(stats));
+    return lp;
 }
 
 } // namespace mps 
\ No newline at end of file
@@ -1,8 +1,13 @@
 #ifndef MPS_PARSER_H
 #define MPS_PARSER_H
 
+#include "counting_resource.h"
 #include "lp_data.h"
+#include "mps_reader.h"
+#include "symbol_table.h"
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -14,28 +19,129 @@ namespace mps {
 // Forward declarations
 class ParserState;
 
+/**
+ * Receives the constraint coefficients in place of the parser's column storage
+ * (ParseOptions::coefficient_sink), so a consumer can write them out while the file
+ * is still being read and the full matrices never exist in memory.
+ */
+class CoefficientSink {
+public:
+    virtual ~CoefficientSink() = default;
+
+    /**
+     * Entries of column col, once the column is complete. Rows are the state's row ids
+     * (every row is declared by then, see ParserState::get_row_type), each at most once;
+     * objective coefficients are not included. A column that reappears later in COLUMNS
+     * arrives again with the new entries only, one call per entry.
+     */
+    virtual void add_column(const ParserState& state, int col, const int* rows, const double* values,
+                            size_t count) = 0;
+};
+
 // Constants
 constexpr std::chrono::seconds TIMEOUT_SECONDS{1000};
 
+// Input backends for parse_mps
+enum class ReaderBackend {
+    Stream,  // std::getline + std::istringstream per line (original implementation)
+    Mmap     // memory-mapped file walked with std::string_view tokens, no per-line allocations
+};
+// Either backend also reads .gz/.bz2/.zst files, decoding them on a background thread
+// (see compressed_input.h); Mmap then runs its view parsers over the decoded lines, serially.
+
+// How the constraint matrices are assembled from the parsed coefficients
+enum class MatrixAssembly {
+    Triplets,  // Eigen triplet list + setFromTriplets (sorts every nonzero)
+    Direct     // compressed column storage filled while parsing, split by a row permutation
+};
+
+// Options controlling how parse_mps reads a file
+struct ParseOptions {
+    ReaderBackend backend = ReaderBackend::Mmap;
+    MatrixAssembly assembly = MatrixAssembly::Direct;
+    // Worker threads for the COLUMNS section (Mmap backend, uncompressed input); 1 = serial, 0 = all cores
+    int num_threads = 1;
+    // Count rows, columns and nonzeros in a quick pass first and reserve the parser's containers
+    // from it (Mmap backend, uncompressed input), instead of growing them while parsing
+    bool presize = false;
+    // Backing memory for the parser's names and tables; nullptr = a monotonic arena owned by
+    // the parse, released in one go when it ends. Must outlive the parse_mps call.
+    std::pmr::memory_resource* memory_resource = nullptr;
+    // Receives the constraint coefficients column by column instead of the model; the returned
+    // LpData then has A_eq/A_ineq with their shapes but no entries. Memory for coefficients
+    // stays at one column whatever the number of nonzeros.
+    CoefficientSink* coefficient_sink = nullptr;
+};
+
+// Container sizes counted by prescan_mps_sizes. Upper bounds: columns are counted at every
+// change of column name and nonzeros include objective coefficients.
+struct MpsSizeHints {
+    size_t rows = 0;
+    size_t columns = 0;
+    size_t nonzeros = 0;
+};
+
+/**
+ * Counts rows, columns and nonzeros of an MPS text without parsing names or numbers:
+ * ROWS lines are counted, COLUMNS lines only compare their first field with the previous
+ * line's and count the remaining fields.
+ * @param text The whole MPS file
+ * @return The counts, for ParserState::reserve
+ */
+MpsSizeHints prescan_mps_sizes(std::string_view text);
+
 // Main parsing function
-std::unique_ptr<LpData> parse_mps(const std::string& path);
+std::unique_ptr<LpData> parse_mps(const std::string& path, const ParseOptions& options = ParseOptions());
+
+// Same, also filling scan with the file's problem name, line count and section layout,
+// collected during the parse instead of by separate passes over the file
+std::unique_ptr<LpData> parse_mps(const std::string& path, const ParseOptions& options, MpsScan& scan);
 
 class ParserState {
 public:
-    ParserState();
+    // Everything the state owns is allocated from resource; nullptr = an internal monotonic
+    // arena, so the many small name and table allocations become a few large blocks
+    explicit ParserState(std::pmr::memory_resource* resource = nullptr);
     ~ParserState();
 
+    ParserState(const ParserState&) = delete;
+    ParserState& operator=(const ParserState&) = delete;
+
     // Getters
-    const std::vector<std::string>& get_row_names() const { return row_names_; }
-    const std::vector<std::string>& get_col_names() const { return col_names_; }
+    int get_num_rows() const { return row_ids_.size(); }
+    int get_num_cols() const { return col_ids_.size(); }
+    std::string_view get_row_name(int id) const { return row_ids_.name(id); }
+    std::string_view get_col_name(int id) const { return col_ids_.name(id); }
     const std::string& get_objective_name() const { return objective_name_; }
+    int get_objective_row() const { return objective_row_; }
+    char get_row_type(int id) const { return row_types_[id]; }
+
+    // Allocations that reached the arena's upstream (or the caller's resource)
+    const AllocationStats& get_allocation_stats() const { return counting_.stats(); }
+
+    // Copies the column names out of the state's memory (used once parsing is complete)
+    std::vector<std::string> copy_col_names() const;
 
     // State modification methods
-    void add_row(const std::string& name, char type);
-    void add_column_coefficient(const std::string& col_name, const std::string& row_name, double value);
-    void add_rhs_value(const std::string& row_name, double value);
-    void add_bound(const std::string& type, const std::string& col_name, double value);
-    void set_objective_name(const std::string& name) { objective_name_ = name; }
+    void add_row(std::string_view name, char type);
+    void add_column_coefficient(std::string_view col_name, std::string_view row_name, double value);
+    void add_rhs_value(std::string_view row_name, double value);
+    void add_bound(std::string_view type, std::string_view col_name, double value);
+    void set_objective_name(const std::string& name);
+
+    // Reserves every per-row, per-column and per-entry container for the given sizes
+    // (per-entry ones only without a coefficient sink)
+    void reserve(const MpsSizeHints& sizes);
+
+    // Hands the constraint coefficients to sink as each column completes instead of storing them
+    void set_coefficient_sink(CoefficientSink* sink) { sink_ = sink; }
+    // Passes the last column to the sink once COLUMNS is done (no-op without a sink)
+    void flush_coefficients();
+
+    // Id-based interface: rows are looked up once, columns interned once per run of lines
+    int find_row(std::string_view name) const { return row_ids_.find(name); }
+    int add_column(std::string_view name);
+    void add_coefficient(int col, int row, double value);
 
     // Matrix construction helpers
     void set_default_bounds();
@@ -45,18 +151,46 @@ public:
                        Eigen::SparseMatrix<double>& A_eq,
                        Eigen::VectorXd& b_eq,
                        Eigen::SparseMatrix<double>& A_ineq,
-                       Eigen::VectorXd& b_ineq) const;
+                       Eigen::VectorXd& b_ineq,
+                       MatrixAssembly assembly = MatrixAssembly::Direct,
+                       double* assembly_seconds = nullptr) const;
 
 private:
-    std::vector<std::string> row_names_;
-    std::vector<std::string> col_names_;
-    std::unordered_map<std::string, int> col_name_to_index_; // Map column name to its index
+    // Column-major coefficients with every column's rows unique (out-of-order entries merged in)
+    struct ColumnEntries {
+        std::vector<int> col_start;
+        std::vector<int> rows;
+        std::vector<double> values;
+    };
+    ColumnEntries merge_out_of_order_entries() const;
+    // Hands the buffered entries of col (the newest column) to sink_
+    void send_column(int col);
+
+    // Declared first so they outlive every container below
+    CountingResource counting_;
+    std::pmr::monotonic_buffer_resource arena_;
+    std::pmr::memory_resource* resource_;  // &arena_, or &counting_ over the caller's resource
+
+    // Row and column names are interned to dense ids when first seen; everything below is keyed by id
+    SymbolTable row_ids_;
+    SymbolTable col_ids_;
     std::string objective_name_;
-    std::unordered_map<std::string, std::unordered_map<std::string, double>> constraints_;  // row -> (col -> value)
-    std::unordered_map<std::string, double> objective_;  // col -> value
-    std::unordered_map<std::string, double> rhs_values_;  // row -> value
-    std::unordered_map<std::string, std::pair<double, double>> bounds_;  // col -> (lower, upper)
-    std::unordered_map<std::string, char> row_types_;  // row -> type (N, E, L, G)
+    int objective_row_ = -1;
+    std::pmr::vector<char> row_types_;  // row id -> type (N, E, L, G)
+    std::pmr::vector<double> rhs_values_;  // row id -> value
+    std::pmr::vector<double> objective_;  // col id -> value
+    std::pmr::vector<std::pair<double, double>> bounds_;  // col id -> (lower, upper)
+    // Constraint coefficients in compressed column storage, appended while parsing.
+    // COLUMNS lists each column contiguously, so entries of the newest column are appended
+    // in place; entries for a column that reappears later go to out_of_order_entries_.
+    std::pmr::vector<int> col_start_;  // col id -> first entry; last element = entry count
+    std::pmr::vector<int> entry_rows_;
+    std::pmr::vector<double> entry_values_;
+    std::pmr::vector<Eigen::Triplet<double>> out_of_order_entries_;
+    std::pmr::vector<int> row_last_col_;   // row id -> newest column holding an entry for it
+    std::pmr::vector<int> row_last_entry_; // row id -> that entry's index (repeats overwrite it)
+    // With a sink, entry_rows_/entry_values_ only hold the newest column and col_start_ stays zero
+    CoefficientSink* sink_ = nullptr;
 };
 
 // Section parsing functions
@@ -65,6 +199,13 @@ void parse_columns_section(const std::string& line, ParserState& state);
 void parse_rhs_section(const std::string& line, ParserState& state);
 void parse_bounds_section(const std::string& line, ParserState& state);
 
+// Zero-copy section parsing functions used by the Mmap backend.
+// The line must already be trimmed; tokens are views into it.
+void parse_rows_view(std::string_view line, ParserState& state);
+void parse_columns_view(std::string_view line, ParserState& state);
+void parse_rhs_view(std::string_view line, ParserState& state);
+void parse_bounds_view(std::string_view line, ParserState& state);
+
 } // namespace mps
 
 #endif // MPS_PARSER_H 
\ No newline at end of file
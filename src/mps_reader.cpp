@@ -1,4 +1,6 @@
 #include "mps_reader.h"
+#include "compressed_input.h"
+#include "mps_tokenizer.h"
 #include <fstream>
 #include <stdexcept>
 #include <string>
@@ -6,11 +8,77 @@
 
 namespace mps {
 
-int count_lines(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
+const MpsSection* MpsScan::find_section(std::string_view name) const {
+    for (const auto& section : sections) {
+        if (section.name == name) return &section;
+    }
+    return nullptr;
+}
+
+void MpsScanRecorder::section(std::string_view header, size_t line_num, size_t byte_offset) {
+    finish(line_num - 1, byte_offset);
+    if (is_name_line(header)) {
+        scan_.problem_name = std::string(trim_view(header.substr(4)));
+        header = header.substr(0, 4);
     }
+    scan_.sections.push_back({std::string(header), byte_offset});
+    header_line_ = line_num;
+    header_time_ = std::chrono::steady_clock::now();
+}
+
+void MpsScanRecorder::finish(size_t line_num, size_t byte_offset) {
+    if (!scan_.sections.empty()) {
+        MpsSection& last = scan_.sections.back();
+        last.line_count = line_num - header_line_;
+        last.bytes = byte_offset - last.byte_offset;
+        last.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - header_time_).count();
+    }
+    scan_.line_count = line_num;
+    scan_.byte_count = byte_offset;
+}
+
+void MpsScanRecorder::endata(size_t line_num, size_t byte_offset) {
+    finish(line_num - 1, byte_offset);
+    scan_.line_count = line_num;
+}
+
+MpsScan scan_mps_header(const std::string& filename) {
+    auto input = open_mps_input(filename);
+    std::istream& file = *input;
+
+    MpsScan scan;
+    scan.header_only = true;
+    MpsScanRecorder recorder(scan);
+
+    std::string line;
+    size_t line_num = 0;
+    size_t offset = 0;
+    while (std::getline(file, line)) {
+        const size_t line_offset = offset;
+        offset += line.size() + 1;
+        ++line_num;
+
+        const std::string_view trimmed = trim_view(line);
+        if (trimmed == "ENDATA") {
+            recorder.endata(line_num, line_offset);
+            return scan;
+        }
+        if ((scan.sections.empty() && is_name_line(trimmed)) || trimmed == "ROWS" || trimmed == "COLUMNS" || trimmed == "RHS" ||
+            trimmed == "RANGES" || trimmed == "BOUNDS") {
+            recorder.section(trimmed, line_num, line_offset);
+            if (trimmed == "COLUMNS") {
+                scan.line_count = line_num;
+                return scan;
+            }
+        }
+    }
+    recorder.finish(line_num, offset);
+    return scan;
+}
+
+int count_lines(const std::string& filename) {
+    auto input = open_mps_input(filename);
+    std::istream& file = *input;
 
     int lineCount = 0;
     std::string line;
@@ -18,15 +86,12 @@ int count_lines(const std::string& filename) {
         lineCount++;
     }
 
-    file.close();
     return lineCount;
 }
 
 std::string read_problem_name(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    auto input = open_mps_input(filename);
+    std::istream& file = *input;
 
     std::string line;
     if (!std::getline(file, line)) {
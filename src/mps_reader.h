@@ -1,13 +1,73 @@
 #ifndef MPS_READER_H
 #define MPS_READER_H
 
+#include <chrono>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace mps {
 
+// One section of an MPS file as located by a scan
+struct MpsSection {
+    std::string name;        // header keyword: NAME, ROWS, COLUMNS, RHS, RANGES or BOUNDS
+    size_t byte_offset = 0;  // start of the header line (in the decoded text for compressed input)
+    size_t line_count = 0;   // lines between the header and the next header or ENDATA
+    size_t bytes = 0;        // bytes from the header to the next header or ENDATA
+    double seconds = 0.0;    // wall time from reaching the header to reaching the next one
+};
+
+// Layout of an MPS file, collected by the pass that reads it
+struct MpsScan {
+    std::string problem_name;
+    size_t line_count = 0;             // lines read, up to and including ENDATA
+    size_t byte_count = 0;             // bytes read before ENDATA
+    std::vector<MpsSection> sections;  // in file order
+    bool header_only = false;          // stopped at the COLUMNS header (see scan_mps_header)
+
+    // First section with the given header, or nullptr if the file has none
+    const MpsSection* find_section(std::string_view name) const;
+};
+
+/**
+ * Fills an MpsScan from the section headers a reader comes across, so the layout
+ * is a by-product of a pass over the file rather than a pass of its own.
+ * Each section is timed from its header to the next, including any parsing in between.
+ */
+class MpsScanRecorder {
+public:
+    explicit MpsScanRecorder(MpsScan& scan) : scan_(scan) {}
+
+    // A trimmed header line (NAME may carry the problem name) on 1-based line line_num
+    void section(std::string_view header, size_t line_num, size_t byte_offset);
+
+    // The ENDATA line, on 1-based line line_num starting at byte_offset
+    void endata(size_t line_num, size_t byte_offset);
+
+    // Closes the last section once line_num lines and byte_offset bytes have been read
+    void finish(size_t line_num, size_t byte_offset);
+
+private:
+    MpsScan& scan_;
+    size_t header_line_ = 0;
+    std::chrono::steady_clock::time_point header_time_;
+};
+
+/**
+ * Reads an MPS file up to its COLUMNS header: problem name, NAME/ROWS layout and
+ * the COLUMNS offset, for sizing decisions before the model is parsed.
+ * The COLUMNS entry has no line count; parse_mps(path, options, scan) gives the full layout.
+ * @param filename Path to the MPS file (plain or .gz/.bz2/.zst)
+ * @return The scan with header_only set
+ * @throws std::runtime_error if the file cannot be opened
+ */
+MpsScan scan_mps_header(const std::string& filename);
+
 /**
  * Counts the number of lines in an MPS file.
- * @param filename Path to the MPS file
+ * Reads the whole file; MpsScan::line_count has it for free when the file is parsed anyway.
+ * @param filename Path to the MPS file (plain or .gz/.bz2/.zst)
  * @return Number of lines in the file
  * @throws std::runtime_error if the file cannot be opened
  */
@@ -15,7 +75,7 @@ int count_lines(const std::string& filename);
 
 /**
  * Reads and validates the NAME section of an MPS file.
- * @param filename Path to the MPS file
+ * @param filename Path to the MPS file (plain or .gz/.bz2/.zst)
  * @return The problem name from the NAME section
  * @throws std::runtime_error if the file cannot be opened or if the NAME section is invalid
  */
@@ -23,4 +83,4 @@ std::string read_problem_name(const std::string& filename);
 
 } // namespace mps
 
-#endif // MPS_READER_H 
\ No newline at end of file
+#endif // MPS_READER_H
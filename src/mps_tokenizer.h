@@ -0,0 +1,88 @@
+#ifndef MPS_TOKENIZER_H
+#define MPS_TOKENIZER_H
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace mps {
+
+// Field separators in free-format MPS ('\r' covers files with Windows line endings)
+inline bool is_mps_space(char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+// Strips leading and trailing separators without copying
+inline std::string_view trim_view(std::string_view text) {
+    size_t begin = 0;
+    size_t end = text.size();
+    while (begin < end && is_mps_space(text[begin])) ++begin;
+    while (end > begin && is_mps_space(text[end - 1])) --end;
+    return text.substr(begin, end - begin);
+}
+
+// True for the NAME header, with or without the problem name on the same line. Only a
+// header before the first other section: later, a line starting with a column or RHS
+// vector named NAME is data.
+inline bool is_name_line(std::string_view line) {
+    return line.substr(0, 4) == "NAME" && (line.size() == 4 || is_mps_space(line[4]));
+}
+
+/**
+ * Walks a character buffer line by line, returning views into the buffer.
+ * The buffer must outlive the reader and every line it hands out.
+ */
+class LineReader {
+public:
+    explicit LineReader(std::string_view buffer) : buffer_(buffer) {}
+
+    // Stores the next line (without its '\n') in line; returns false at end of buffer
+    bool next(std::string_view& line) {
+        if (pos_ >= buffer_.size()) return false;
+        const char* begin = buffer_.data() + pos_;
+        const size_t remaining = buffer_.size() - pos_;
+        const void* newline = std::memchr(begin, '\n', remaining);
+        const size_t length = newline
+            ? static_cast<size_t>(static_cast<const char*>(newline) - begin)
+            : remaining;
+        line = std::string_view(begin, length);
+        pos_ += newline ? length + 1 : length;
+        return true;
+    }
+
+    // Byte offset of the first character not yet returned
+    size_t position() const { return pos_; }
+
+    // Continues reading from the given byte offset (must be the start of a line)
+    void skip_to(size_t position) { pos_ = position; }
+
+private:
+    std::string_view buffer_;
+    size_t pos_ = 0;
+};
+
+/**
+ * Splits one line into whitespace-separated fields, returning views into the line.
+ */
+class TokenCursor {
+public:
+    explicit TokenCursor(std::string_view line) : line_(line) {}
+
+    // Stores the next field in token; returns false when the line is exhausted
+    bool next(std::string_view& token) {
+        while (pos_ < line_.size() && is_mps_space(line_[pos_])) ++pos_;
+        if (pos_ >= line_.size()) return false;
+        const size_t begin = pos_;
+        while (pos_ < line_.size() && !is_mps_space(line_[pos_])) ++pos_;
+        token = line_.substr(begin, pos_ - begin);
+        return true;
+    }
+
+private:
+    std::string_view line_;
+    size_t pos_ = 0;
+};
+
+} // namespace mps
+
+#endif // MPS_TOKENIZER_H
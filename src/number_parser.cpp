@@ -0,0 +1,65 @@
+#include "number_parser.h"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace mps {
+
+namespace {
+
+[[noreturn]] void throw_invalid(std::string_view token) {
+    throw std::runtime_error("Invalid numeric value: " + std::string(token));
+}
+
+// strtod on a terminated copy of the token; handles overflow/underflow and
+// stands in for from_chars on standard libraries without floating-point support
+double parse_with_strtod(std::string_view token) {
+    char buffer[64];
+    std::string long_token;
+    const char* text = buffer;
+    if (token.size() < sizeof(buffer)) {
+        std::memcpy(buffer, token.data(), token.size());
+        buffer[token.size()] = '\0';
+    } else {
+        long_token.assign(token);
+        text = long_token.c_str();
+    }
+
+    char* end = nullptr;
+    const double value = std::strtod(text, &end);
+    if (end != text + token.size()) {
+        throw_invalid(token);
+    }
+    return value;
+}
+
+} // namespace
+
+double parse_double(std::string_view token) {
+    // from_chars rejects an explicit '+' sign, which some MPS writers emit
+    const bool explicit_plus = !token.empty() && token[0] == '+';
+    const std::string_view digits = explicit_plus ? token.substr(1) : token;
+    if (digits.empty() || (explicit_plus && (digits[0] == '+' || digits[0] == '-'))) {
+        throw_invalid(token);
+    }
+
+#if defined(__cpp_lib_to_chars)
+    double value = 0.0;
+    const char* last = digits.data() + digits.size();
+    const auto [end, ec] = std::from_chars(digits.data(), last, value);
+    if (ec == std::errc::invalid_argument || end != last) {
+        throw_invalid(token);
+    }
+    if (ec == std::errc::result_out_of_range) {
+        return parse_with_strtod(token);
+    }
+    return value;
+#else
+    return parse_with_strtod(token);
+#endif
+}
+
+} // namespace mps
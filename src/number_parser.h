@@ -0,0 +1,22 @@
+#ifndef NUMBER_PARSER_H
+#define NUMBER_PARSER_H
+
+#include <string_view>
+
+namespace mps {
+
+/**
+ * Converts a numeric MPS field to double without allocating or consulting the locale.
+ * Uses std::from_chars (correctly rounded, so printed values round-trip exactly) and accepts
+ * an explicit '+' sign and infinity spellings such as "Inf", "-infinity" or "+INF".
+ * Large finite markers like 1e30 are returned as-is; values beyond the double range
+ * become +/-infinity (or zero on underflow) as with strtod.
+ * @param token The field to convert
+ * @return The parsed value
+ * @throws std::runtime_error if the field is not a complete number
+ */
+double parse_double(std::string_view token);
+
+} // namespace mps
+
+#endif // NUMBER_PARSER_H
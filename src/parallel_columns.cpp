@@ -0,0 +1,138 @@
+#include "parallel_columns.h"
+#include "mps_tokenizer.h"
+#include "number_parser.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mps {
+
+namespace {
+
+// Chunks smaller than this are not worth a thread
+constexpr size_t kMinChunkBytes = 64 * 1024;
+
+// One worker's output: coefficients grouped into runs of consecutive lines for the same column
+struct ColumnChunk {
+    std::vector<std::string_view> run_names;  // views into the mapped file
+    std::vector<size_t> run_ends;             // entry index one past each run's last coefficient
+    std::vector<int> rows;                    // row id per coefficient (-1 = row not in ROWS)
+    std::vector<double> values;
+    size_t line_count = 0;
+    size_t error_line = 0;                    // 1-based line within the chunk, 0 = no error
+    std::string error;
+};
+
+void parse_chunk(std::string_view chunk, const ParserState& state, ColumnChunk& out) {
+    LineReader lines(chunk);
+    std::string_view line, col_name, row_name, value;
+    while (lines.next(line)) {
+        ++out.line_count;
+        line = trim_view(line);
+        if (line.empty() || line[0] == '*') continue;
+
+        try {
+            TokenCursor tokens(line);
+            tokens.next(col_name);
+            if (col_name == "'MARKER'") continue;
+
+            while (tokens.next(row_name)) {
+                // Integrality markers: "MARKER 'MARKER' 'INTORG'"
+                if (row_name == "'MARKER'") break;
+                if (!tokens.next(value)) {
+                    throw std::runtime_error("Missing value for row " + std::string(row_name));
+                }
+                const double parsed = parse_double(value);
+
+                // A column only exists once it has a coefficient, as in the serial parser
+                if (out.run_names.empty() || out.run_names.back() != col_name) {
+                    out.run_names.push_back(col_name);
+                    out.run_ends.push_back(out.rows.size());
+                }
+                out.rows.push_back(state.find_row(row_name));
+                out.values.push_back(parsed);
+                out.run_ends.back() = out.rows.size();
+            }
+        } catch (const std::exception& e) {
+            out.error_line = out.line_count;
+            out.error = e.what();
+            return;
+        }
+    }
+}
+
+} // namespace
+
+void parse_columns_parallel(std::string_view columns, size_t first_line_num,
+                            ParserState& state, int num_threads) {
+    if (num_threads <= 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    const size_t max_chunks = std::max<size_t>(1, columns.size() / kMinChunkBytes);
+    const size_t n_chunks = std::min<size_t>(num_threads, max_chunks);
+
+    // Split at line boundaries
+    std::vector<size_t> bounds(n_chunks + 1, columns.size());
+    bounds[0] = 0;
+    for (size_t i = 1; i < n_chunks; ++i) {
+        size_t pos = std::max(bounds[i - 1], columns.size() * i / n_chunks);
+        const void* newline = pos < columns.size()
+            ? std::memchr(columns.data() + pos, '\n', columns.size() - pos)
+            : nullptr;
+        bounds[i] = newline ? static_cast<const char*>(newline) - columns.data() + 1 : columns.size();
+    }
+
+    // Workers only read the state (row lookups); the merge below is the only writer
+    std::vector<ColumnChunk> chunks(n_chunks);
+    std::vector<std::thread> workers;
+    // If the merge (or starting a worker) throws, join whatever is still running before
+    // the exception leaves: destroying a joinable std::thread terminates the program
+    struct JoinGuard {
+        std::vector<std::thread>& threads;
+        ~JoinGuard() {
+            for (auto& thread : threads) {
+                if (thread.joinable()) thread.join();
+            }
+        }
+    } join_guard{workers};
+    workers.reserve(n_chunks);
+    for (size_t i = 0; i < n_chunks; ++i) {
+        const std::string_view chunk = columns.substr(bounds[i], bounds[i + 1] - bounds[i]);
+        workers.emplace_back(parse_chunk, chunk, std::cref(state), std::ref(chunks[i]));
+    }
+
+    // Merge in file order as each worker finishes, releasing its buffers right away
+    size_t line_offset = first_line_num;
+    std::string error;
+    for (size_t i = 0; i < n_chunks; ++i) {
+        workers[i].join();
+        ColumnChunk& chunk = chunks[i];
+        if (error.empty() && !chunk.error.empty()) {
+            error = "Error parsing line " + std::to_string(line_offset + chunk.error_line) +
+                    " in section COLUMNS: " + chunk.error;
+        }
+        if (error.empty()) {
+            size_t begin = 0;
+            for (size_t r = 0; r < chunk.run_names.size(); ++r) {
+                const int col = state.add_column(chunk.run_names[r]);
+                for (size_t k = begin; k < chunk.run_ends[r]; ++k) {
+                    if (chunk.rows[k] >= 0) {
+                        state.add_coefficient(col, chunk.rows[k], chunk.values[k]);
+                    }
+                }
+                begin = chunk.run_ends[r];
+            }
+        }
+        line_offset += chunk.line_count;
+        chunk = ColumnChunk();
+    }
+
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+} // namespace mps
@@ -0,0 +1,27 @@
+#ifndef PARALLEL_COLUMNS_H
+#define PARALLEL_COLUMNS_H
+
+#include "mps_parser.h"
+#include <cstddef>
+#include <string_view>
+
+namespace mps {
+
+/**
+ * Parses the body of a COLUMNS section on several threads.
+ * The text is split at line boundaries; each worker tokenizes its chunk, converts the
+ * numbers and resolves row ids into a private buffer. Chunks are then merged in file
+ * order, so columns receive the same ids and the state ends up exactly as if the
+ * lines had been fed to parse_columns_view one by one.
+ * @param columns The section body (every line after the COLUMNS header up to the next header)
+ * @param first_line_num Number of lines in the file before the section body, for error messages
+ * @param state Parser state with the ROWS section already loaded
+ * @param num_threads Number of worker threads (0 = hardware concurrency)
+ * @throws std::runtime_error naming the first offending line if any line is malformed
+ */
+void parse_columns_parallel(std::string_view columns, size_t first_line_num,
+                            ParserState& state, int num_threads);
+
+} // namespace mps
+
+#endif // PARALLEL_COLUMNS_H
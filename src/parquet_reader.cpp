@@ -0,0 +1,333 @@
+#include "parquet_reader.h"
+#include "parquet_writer.h"
+#include <arrow/io/api.h>
+#include <arrow/ipc/api.h>
+#include <parquet/arrow/reader.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace mps {
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+// Returns the single chunk of a column of a table whose chunks were combined
+template <typename ArrayType>
+arrow::Result<std::shared_ptr<ArrayType>> single_chunk(const arrow::Table& table, const std::string& name,
+                                                       arrow::Type::type type_id) {
+    auto column = table.GetColumnByName(name);
+    if (!column) {
+        return arrow::Status::Invalid("Missing column: ", name);
+    }
+    if (column->type()->id() != type_id) {
+        return arrow::Status::TypeError("Unexpected type for column ", name, ": ", column->type()->ToString());
+    }
+    if (column->num_chunks() == 0) {
+        return std::make_shared<ArrayType>(0, nullptr);
+    }
+    return std::static_pointer_cast<ArrayType>(column->chunk(0));
+}
+
+// Single chunk of an index column, which the writer made int32 or int64
+arrow::Result<std::shared_ptr<arrow::Array>> index_column(const arrow::Table& table, const std::string& name) {
+    auto column = table.GetColumnByName(name);
+    if (!column) {
+        return arrow::Status::Invalid("Missing column: ", name);
+    }
+    if (column->type()->id() != arrow::Type::INT32 && column->type()->id() != arrow::Type::INT64) {
+        return arrow::Status::TypeError("Unexpected type for column ", name, ": ", column->type()->ToString());
+    }
+    if (column->num_chunks() == 0) {
+        return arrow::MakeEmptyArray(column->type());
+    }
+    return column->chunk(0);
+}
+
+template <typename ArrowIndex>
+const typename ArrowIndex::c_type* index_values(const arrow::Array& array) {
+    return static_cast<const arrow::NumericArray<ArrowIndex>&>(array).raw_values();
+}
+
+template <typename Index>
+arrow::Result<Eigen::SparseMatrix<double>> coo_to_matrix(const Index* row_idx, const Index* col_idx,
+                                                         const double* values, int64_t nnz, int rows, int cols,
+                                                         const std::string& filename) {
+    // save_coo_matrix emits entries column by column with rows ascending; check for that order
+    bool column_major = true;
+    for (int64_t k = 0; k < nnz; ++k) {
+        if (row_idx[k] < 0 || row_idx[k] >= rows || col_idx[k] < 0 || col_idx[k] >= cols) {
+            return arrow::Status::Invalid("Entry ", k, " out of bounds in ", filename);
+        }
+        if (k > 0 && (col_idx[k] < col_idx[k - 1] ||
+                      (col_idx[k] == col_idx[k - 1] && row_idx[k] <= row_idx[k - 1]))) {
+            column_major = false;
+        }
+    }
+
+    Eigen::SparseMatrix<double> matrix(rows, cols);
+    if (column_major) {
+        // Fill the compressed storage directly: count per column, then copy indices and values
+        matrix.resizeNonZeros(nnz);
+        auto* outer = matrix.outerIndexPtr();
+        for (int64_t k = 0; k < nnz; ++k) {
+            ++outer[col_idx[k] + 1];
+        }
+        for (int j = 0; j < cols; ++j) {
+            outer[j + 1] += outer[j];
+        }
+        auto* inner = matrix.innerIndexPtr();
+        for (int64_t k = 0; k < nnz; ++k) {
+            inner[k] = static_cast<int>(row_idx[k]);
+        }
+        if (nnz > 0) {
+            std::memcpy(matrix.valuePtr(), values, nnz * sizeof(double));
+        }
+    } else {
+        // A streamed conversion writes entries in file order, so a (row, col) pair repeated
+        // by a column listed twice in COLUMNS keeps its last value, as parse_mps does
+        std::vector<Eigen::Triplet<double>> triplets;
+        triplets.reserve(nnz);
+        for (int64_t k = 0; k < nnz; ++k) {
+            triplets.emplace_back(row_idx[k], col_idx[k], values[k]);
+        }
+        matrix.setFromTriplets(triplets.begin(), triplets.end(), [](double, double later) { return later; });
+    }
+    return matrix;
+}
+
+// Copies indptr/indices/data into a compressed matrix of the same storage order after
+// checking that they describe a rows x cols matrix
+template <typename Matrix, typename Index>
+arrow::Result<Matrix> compressed_to_matrix(const Index* indptr, int64_t indptr_length, const Index* indices,
+                                           const double* values, int64_t nnz, int rows, int cols,
+                                           const std::string& filename) {
+    Matrix matrix(rows, cols);
+    const int64_t outer_size = matrix.outerSize();
+    const int64_t inner_size = matrix.innerSize();
+    if (indptr_length != outer_size + 1 || indptr[0] != 0 || indptr[outer_size] != nnz) {
+        return arrow::Status::Invalid("Offsets do not match the matrix shape in ", filename);
+    }
+    for (int64_t j = 0; j < outer_size; ++j) {
+        if (indptr[j + 1] < indptr[j]) {
+            return arrow::Status::Invalid("Decreasing offset ", j + 1, " in ", filename);
+        }
+    }
+    for (int64_t k = 0; k < nnz; ++k) {
+        if (indices[k] < 0 || indices[k] >= inner_size) {
+            return arrow::Status::Invalid("Entry ", k, " out of bounds in ", filename);
+        }
+    }
+
+    matrix.resizeNonZeros(nnz);
+    std::copy(indptr, indptr + outer_size + 1, matrix.outerIndexPtr());
+    std::copy(indices, indices + nnz, matrix.innerIndexPtr());
+    std::copy(values, values + nnz, matrix.valuePtr());
+    return matrix;
+}
+
+template <typename ArrowIndex>
+arrow::Result<Eigen::SparseMatrix<double>> compressed_to_matrix(const arrow::Array& indptr, const arrow::Array& indices,
+                                                                const arrow::DoubleArray& data, MatrixLayout layout,
+                                                                int rows, int cols, const std::string& filename) {
+    const auto* indptr_values = index_values<ArrowIndex>(indptr);
+    const auto* index = index_values<ArrowIndex>(indices);
+    if (layout == MatrixLayout::Csr) {
+        ARROW_ASSIGN_OR_RAISE(auto csr, (compressed_to_matrix<Eigen::SparseMatrix<double, Eigen::RowMajor>>(
+            indptr_values, indptr.length(), index, data.raw_values(), data.length(), rows, cols, filename)));
+        return Eigen::SparseMatrix<double>(csr);
+    }
+    return compressed_to_matrix<Eigen::SparseMatrix<double>>(indptr_values, indptr.length(), index, data.raw_values(),
+                                                             data.length(), rows, cols, filename);
+}
+
+} // namespace
+
+arrow::Result<std::shared_ptr<arrow::Table>> read_parquet_table(const std::string& filename) {
+    ARROW_ASSIGN_OR_RAISE(auto infile, arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ));
+    ARROW_ASSIGN_OR_RAISE(auto reader, parquet::arrow::OpenFile(infile, arrow::default_memory_pool()));
+
+    std::shared_ptr<arrow::Table> table;
+    ARROW_RETURN_NOT_OK(reader->ReadTable(&table));
+
+    // One chunk per row group; merge them so each column is one contiguous array
+    return table->CombineChunks();
+}
+
+arrow::Result<std::shared_ptr<arrow::Table>> read_feather_table(const std::string& filename) {
+    ARROW_ASSIGN_OR_RAISE(auto infile, arrow::io::MemoryMappedFile::Open(filename, arrow::io::FileMode::READ));
+    ARROW_ASSIGN_OR_RAISE(auto reader, arrow::ipc::RecordBatchFileReader::Open(infile));
+    ARROW_ASSIGN_OR_RAISE(auto table, reader->ToTable());
+
+    // One chunk per record batch
+    return table->CombineChunks();
+}
+
+arrow::Result<std::shared_ptr<arrow::Table>> read_table(const std::string& filename) {
+    if (fs::path(filename).extension() == ".feather") {
+        return read_feather_table(filename);
+    }
+    return read_parquet_table(filename);
+}
+
+arrow::Result<Eigen::VectorXd> load_vector(const std::string& filename) {
+    ARROW_ASSIGN_OR_RAISE(auto table, read_table(filename));
+    if (table->num_columns() != 1) {
+        return arrow::Status::Invalid("Expected a single column in ", filename);
+    }
+    const std::string name = table->schema()->field(0)->name();
+    ARROW_ASSIGN_OR_RAISE(auto values, single_chunk<arrow::DoubleArray>(*table, name, arrow::Type::DOUBLE));
+
+    Eigen::VectorXd vec(values->length());
+    if (values->length() > 0) {
+        std::memcpy(vec.data(), values->raw_values(), values->length() * sizeof(double));
+    }
+    return vec;
+}
+
+arrow::Result<std::vector<std::string>> load_names(const std::string& filename) {
+    ARROW_ASSIGN_OR_RAISE(auto table, read_table(filename));
+    if (table->num_columns() != 1) {
+        return arrow::Status::Invalid("Expected a single column in ", filename);
+    }
+    const auto& column = table->column(0);
+    if (column->type()->id() != arrow::Type::STRING) {
+        return arrow::Status::TypeError("Unexpected type for column ", table->schema()->field(0)->name(), ": ",
+                                        column->type()->ToString());
+    }
+
+    std::vector<std::string> names;
+    names.reserve(column->length());
+    for (const auto& chunk : column->chunks()) {
+        const auto& values = static_cast<const arrow::StringArray&>(*chunk);
+        for (int64_t i = 0; i < values.length(); ++i) {
+            names.emplace_back(values.GetView(i));
+        }
+    }
+    return names;
+}
+
+arrow::Result<Eigen::SparseMatrix<double>> load_coo_matrix(const std::string& filename, int rows, int cols) {
+    ARROW_ASSIGN_OR_RAISE(auto table, read_table(filename));
+    ARROW_ASSIGN_OR_RAISE(auto row_array, index_column(*table, "row"));
+    ARROW_ASSIGN_OR_RAISE(auto col_array, index_column(*table, "col"));
+    ARROW_ASSIGN_OR_RAISE(auto data_array, single_chunk<arrow::DoubleArray>(*table, "data", arrow::Type::DOUBLE));
+    if (!row_array->type()->Equals(*col_array->type())) {
+        return arrow::Status::TypeError("row and col index types differ in ", filename);
+    }
+
+    const int64_t nnz = table->num_rows();
+    if (row_array->type_id() == arrow::Type::INT32) {
+        return coo_to_matrix(index_values<arrow::Int32Type>(*row_array), index_values<arrow::Int32Type>(*col_array),
+                             data_array->raw_values(), nnz, rows, cols, filename);
+    }
+    return coo_to_matrix(index_values<arrow::Int64Type>(*row_array), index_values<arrow::Int64Type>(*col_array),
+                         data_array->raw_values(), nnz, rows, cols, filename);
+}
+
+arrow::Result<Eigen::SparseMatrix<double>> load_compressed_matrix(const std::string& filename,
+                                                                  const std::string& indptr_filename,
+                                                                  MatrixLayout layout, int rows, int cols) {
+    if (layout == MatrixLayout::Coo) {
+        return arrow::Status::Invalid("load_compressed_matrix reads the CSC and CSR layouts");
+    }
+    ARROW_ASSIGN_OR_RAISE(auto table, read_table(filename));
+    ARROW_ASSIGN_OR_RAISE(auto indptr_table, read_table(indptr_filename));
+    ARROW_ASSIGN_OR_RAISE(auto indices, index_column(*table, "indices"));
+    ARROW_ASSIGN_OR_RAISE(auto indptr, index_column(*indptr_table, "indptr"));
+    ARROW_ASSIGN_OR_RAISE(auto data, single_chunk<arrow::DoubleArray>(*table, "data", arrow::Type::DOUBLE));
+    if (!indices->type()->Equals(*indptr->type())) {
+        return arrow::Status::TypeError("indices and indptr types differ in ", filename);
+    }
+    if (indptr->length() == 0) {
+        return arrow::Status::Invalid("Empty indptr in ", indptr_filename);
+    }
+
+    if (indices->type_id() == arrow::Type::INT32) {
+        return compressed_to_matrix<arrow::Int32Type>(*indptr, *indices, *data, layout, rows, cols, filename);
+    }
+    return compressed_to_matrix<arrow::Int64Type>(*indptr, *indices, *data, layout, rows, cols, filename);
+}
+
+std::unique_ptr<LpData> load_lp_from_parquet(const std::string& output_dir) {
+    const fs::path dir(output_dir);
+
+    std::ifstream metadata_file(dir / "metadata.json");
+    if (!metadata_file.is_open()) {
+        throw std::runtime_error("Failed to open metadata: " + (dir / "metadata.json").string());
+    }
+    json metadata = json::parse(metadata_file);
+    const int n_vars = metadata.at("n_vars").get<int>();
+    const double obj_offset = metadata.value("obj_offset", 0.0);
+    const double parse_time_seconds = metadata.value("parse_time_seconds", 0.0);
+    const std::string format_name = metadata.value("output_format", "parquet");
+    if (format_name != output_format_name(OutputFormat::Parquet) && format_name != output_format_name(OutputFormat::Feather)) {
+        throw std::runtime_error("Unknown output_format in metadata: " + format_name);
+    }
+    const OutputFormat format = parse_output_format(format_name);
+    const std::string layout_name = metadata.value("matrix_layout", "coo");
+    if (layout_name != "coo" && layout_name != "csc" && layout_name != "csr") {
+        throw std::runtime_error("Unknown matrix_layout in metadata: " + layout_name);
+    }
+    const MatrixLayout layout = parse_matrix_layout(layout_name);
+    auto file = [&](const std::string& table) { return dir / table_file_name(table, format); };
+
+    auto require = [](auto result, const std::string& what) {
+        if (!result.ok()) {
+            throw std::runtime_error("Failed to load " + what + ": " + result.status().ToString());
+        }
+        return std::move(result).ValueUnsafe();
+    };
+
+    Eigen::VectorXd c = require(load_vector(file("c").string()), "c vector");
+
+    // Older conversions kept the names in metadata.json
+    std::vector<std::string> col_names;
+    if (fs::exists(file("col_names"))) {
+        col_names = require(load_names(file("col_names").string()), "column names");
+    } else {
+        col_names = metadata.value("col_names", std::vector<std::string>());
+    }
+
+    auto bounds_table = require(read_table(file("bounds").string()), "bounds");
+    auto lb_array = require(single_chunk<arrow::DoubleArray>(*bounds_table, "lb", arrow::Type::DOUBLE), "lb");
+    auto ub_array = require(single_chunk<arrow::DoubleArray>(*bounds_table, "ub", arrow::Type::DOUBLE), "ub");
+    std::pair<Eigen::VectorXd, Eigen::VectorXd> bounds{
+        Eigen::Map<const Eigen::VectorXd>(lb_array->raw_values(), lb_array->length()),
+        Eigen::Map<const Eigen::VectorXd>(ub_array->raw_values(), ub_array->length())};
+
+    // A block is only written when it has rows, and its COO file only when it has nonzeros
+    auto load_block = [&](const std::string& name, Eigen::SparseMatrix<double>& A, Eigen::VectorXd& b) {
+        A.resize(0, n_vars);
+        const fs::path b_path = file("b_" + name);
+        if (!fs::exists(b_path)) return;
+        b = require(load_vector(b_path.string()), "b_" + name + " vector");
+        const fs::path A_path = file(matrix_table_name(name, layout));
+        const int rows = static_cast<int>(b.size());
+        if (fs::exists(A_path) && layout == MatrixLayout::Coo) {
+            A = require(load_coo_matrix(A_path.string(), rows, n_vars), "A_" + name + " matrix");
+        } else if (fs::exists(A_path)) {
+            const fs::path indptr_path = file(matrix_table_name(name, layout) + "_indptr");
+            A = require(load_compressed_matrix(A_path.string(), indptr_path.string(), layout, rows, n_vars),
+                        "A_" + name + " matrix");
+        } else {
+            A.resize(b.size(), n_vars);
+        }
+    };
+
+    Eigen::SparseMatrix<double> A_eq, A_ineq;
+    Eigen::VectorXd b_eq, b_ineq;
+    load_block("eq", A_eq, b_eq);
+    load_block("ineq", A_ineq, b_ineq);
+
+    return std::make_unique<LpData>(n_vars, std::move(c), std::move(bounds), std::move(A_eq), std::move(b_eq),
+                                    std::move(A_ineq), std::move(b_ineq), obj_offset, std::move(col_names),
+                                    parse_time_seconds);
+}
+
+} // namespace mps
@@ -0,0 +1,52 @@
+#ifndef PARQUET_READER_H
+#define PARQUET_READER_H
+
+#include "lp_data.h"
+#include "parquet_writer.h"
+#include <arrow/api.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mps {
+
+// Reads a whole Parquet file through a memory-mapped input
+arrow::Result<std::shared_ptr<arrow::Table>> read_parquet_table(const std::string& filename);
+
+// Reads a whole Feather (Arrow IPC) file through a memory-mapped input; the columns of an
+// uncompressed file point into the mapping
+arrow::Result<std::shared_ptr<arrow::Table>> read_feather_table(const std::string& filename);
+
+// Reads a table written by write_table: Feather for a .feather file, Parquet otherwise
+arrow::Result<std::shared_ptr<arrow::Table>> read_table(const std::string& filename);
+
+// Rebuilds a compressed sparse matrix from a COO file (row, col, data) as written by save_coo_matrix;
+// the index columns may be int32 or int64
+arrow::Result<Eigen::SparseMatrix<double>> load_coo_matrix(const std::string& filename, int rows, int cols);
+
+// Rebuilds a compressed sparse matrix from the CSC or CSR files written by save_compressed_matrix.
+// The offsets and indices are range-checked; indices are assumed sorted within each column (row).
+arrow::Result<Eigen::SparseMatrix<double>> load_compressed_matrix(const std::string& filename,
+                                                                  const std::string& indptr_filename,
+                                                                  MatrixLayout layout, int rows, int cols);
+
+// Reads a single float64 column file as written by save_vector
+arrow::Result<Eigen::VectorXd> load_vector(const std::string& filename);
+
+// Reads a single string column file as written by save_names
+arrow::Result<std::vector<std::string>> load_names(const std::string& filename);
+
+/**
+ * Loads an instance directory written by save_lp_to_parquet (the inverse operation).
+ * Vectors and matrices are read from memory-mapped Parquet or Feather files in the format
+ * and matrix layout metadata.json records, column names from the col_names table;
+ * n_vars, obj_offset and parse_time_seconds come from metadata.json.
+ * @param output_dir Directory such as data/<instance>_parquet
+ * @return The reconstructed LpData, with A_eq/A_ineq in compressed form
+ * @throws std::runtime_error if a file is missing or malformed
+ */
+std::unique_ptr<LpData> load_lp_from_parquet(const std::string& output_dir);
+
+} // namespace mps
+
+#endif // PARQUET_READER_H
@@ -1,199 +1,938 @@
 #include "parquet_writer.h"
+#include "conversion_cache.h"
+#include "log.h"
+#include "lp_snapshot.h"
+#include <arrow/ipc/api.h>
+#include <arrow/util/compression.h>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
 #include <fstream>
-#include <iostream>
+#include <functional>
+#include <future>
+#include <vector>
 
 namespace mps {
 
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
-// Helper function to save a sparse matrix in COO format to parquet
-arrow::Status save_coo_matrix(const Eigen::SparseMatrix<double>& matrix,
-                                           const std::string& filename) {
-    if (matrix.nonZeros() == 0) {
-        return arrow::Status::OK();
+namespace {
+
+// Wraps existing memory as an Arrow buffer without copying; the memory must outlive the buffer
+std::shared_ptr<arrow::Buffer> wrap_buffer(const void* data, int64_t size_bytes) {
+    return std::make_shared<arrow::Buffer>(reinterpret_cast<const uint8_t*>(data), size_bytes);
+}
+
+// float64 column viewing the vector's memory. An empty Eigen vector has a null data(),
+// which must not be wrapped, so it gets an empty array instead.
+arrow::Result<std::shared_ptr<arrow::Array>> double_array(const Eigen::VectorXd& values) {
+    if (values.size() == 0) {
+        return arrow::MakeEmptyArray(arrow::float64());
+    }
+    return std::make_shared<arrow::DoubleArray>(values.size(), wrap_buffer(values.data(), values.size() * sizeof(double)));
+}
+
+arrow::Compression::type to_arrow_compression(CompressionCodec codec) {
+    switch (codec) {
+        case CompressionCodec::Snappy: return arrow::Compression::SNAPPY;
+        case CompressionCodec::Zstd: return arrow::Compression::ZSTD;
+        case CompressionCodec::Lz4: return arrow::Compression::LZ4;
+        case CompressionCodec::Uncompressed: break;
+    }
+    return arrow::Compression::UNCOMPRESSED;
+}
+
+// Parquet writer settings for a table with the given schema
+std::shared_ptr<parquet::WriterProperties> writer_properties(const arrow::Schema& schema,
+                                                             const OutputOptions& options) {
+    parquet::WriterProperties::Builder builder;
+    builder.compression(to_arrow_compression(options.codec));
+    if (options.compression_level) {
+        builder.compression_level(*options.compression_level);
+    }
+    if (options.parquet.dictionary) {
+        builder.enable_dictionary();
+    } else {
+        builder.disable_dictionary();
+    }
+    builder.max_row_group_length(options.row_group_size);
+
+    // BYTE_STREAM_SPLIT replaces dictionary encoding on the float64 columns
+    if (options.parquet.byte_stream_split) {
+        for (const auto& field : schema.fields()) {
+            if (field->type()->id() == arrow::Type::DOUBLE) {
+                builder.disable_dictionary(field->name());
+                builder.encoding(field->name(), parquet::Encoding::BYTE_STREAM_SPLIT);
+            }
+        }
+    }
+    return builder.build();
+}
+
+// Columns of the COO matrix files
+std::shared_ptr<arrow::Schema> coo_schema(const std::shared_ptr<arrow::DataType>& index_type) {
+    return arrow::schema({
+        arrow::field("row", index_type),
+        arrow::field("col", index_type),
+        arrow::field("data", arrow::float64())
+    });
+}
+
+// True if the index columns of a matrix with these dimensions are written as int32
+bool use_int32_indices(const OutputOptions& options, int64_t rows, int64_t cols, int64_t nnz) {
+    constexpr int64_t kMax = std::numeric_limits<int32_t>::max();
+    return options.narrow_indices && rows <= kMax && cols <= kMax && nnz <= kMax;
+}
+
+// Index column of n values; shares the memory when the element types already match
+template <typename ArrowIndex, typename Source>
+arrow::Result<std::shared_ptr<arrow::Array>> index_array(const Source* values, int64_t n) {
+    using Index = typename ArrowIndex::c_type;
+    if constexpr (std::is_same_v<Index, Source>) {
+        return std::make_shared<arrow::NumericArray<ArrowIndex>>(n, wrap_buffer(values, n * sizeof(Index)));
+    } else {
+        ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> buffer, arrow::AllocateBuffer(n * sizeof(Index)));
+        std::copy(values, values + n, reinterpret_cast<Index*>(buffer->mutable_data()));
+        return std::make_shared<arrow::NumericArray<ArrowIndex>>(n, std::move(buffer));
+    }
+}
+
+// Forwards to another stream, adding the time spent inside its Write, Flush and Close calls
+// to seconds. Parquet encodes into memory and hands over finished pages, so the rest of
+// WriteTable is encoding.
+class TimedOutputStream : public arrow::io::OutputStream {
+public:
+    TimedOutputStream(std::shared_ptr<arrow::io::OutputStream> inner, double& seconds)
+        : inner_(std::move(inner)), seconds_(seconds) {}
+
+    arrow::Status Write(const void* data, int64_t nbytes) override {
+        return timed([&] { return inner_->Write(data, nbytes); });
+    }
+    arrow::Status Write(const std::shared_ptr<arrow::Buffer>& data) override {
+        return timed([&] { return inner_->Write(data); });
+    }
+    arrow::Status Flush() override { return timed([&] { return inner_->Flush(); }); }
+    arrow::Status Close() override { return timed([&] { return inner_->Close(); }); }
+    arrow::Result<int64_t> Tell() const override { return inner_->Tell(); }
+    bool closed() const override { return inner_->closed(); }
+
+private:
+    template <typename Call>
+    arrow::Status timed(Call call) {
+        const auto start = std::chrono::steady_clock::now();
+        arrow::Status status = call();
+        seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return status;
+    }
+
+    std::shared_ptr<arrow::io::OutputStream> inner_;
+    double& seconds_;
+};
+
+// One table file being written in an output format. Tables are split into chunks of
+// at most row_group_size rows: Parquet row groups or IPC record batches.
+class TableFileWriter {
+public:
+    virtual ~TableFileWriter() = default;
+    virtual arrow::Status write(const arrow::Table& table) = 0;
+    // Writes the footer; the output stream is left open
+    virtual arrow::Status close() = 0;
+};
+
+class ParquetTableWriter : public TableFileWriter {
+public:
+    ParquetTableWriter(std::unique_ptr<parquet::arrow::FileWriter> writer, int64_t chunk_size)
+        : writer_(std::move(writer)), chunk_size_(chunk_size) {}
+
+    arrow::Status write(const arrow::Table& table) override { return writer_->WriteTable(table, chunk_size_); }
+    arrow::Status close() override { return writer_->Close(); }
+
+private:
+    std::unique_ptr<parquet::arrow::FileWriter> writer_;
+    int64_t chunk_size_;
+};
+
+class FeatherTableWriter : public TableFileWriter {
+public:
+    FeatherTableWriter(std::shared_ptr<arrow::ipc::RecordBatchWriter> writer, int64_t chunk_size)
+        : writer_(std::move(writer)), chunk_size_(chunk_size) {}
+
+    arrow::Status write(const arrow::Table& table) override { return writer_->WriteTable(table, chunk_size_); }
+    arrow::Status close() override { return writer_->Close(); }
+
+private:
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> writer_;
+    int64_t chunk_size_;
+};
+
+// IPC buffer compression; compressed files can no longer be used without decoding
+arrow::Result<arrow::ipc::IpcWriteOptions> feather_write_options(const OutputOptions& options) {
+    auto ipc_options = arrow::ipc::IpcWriteOptions::Defaults();
+    const int level = options.compression_level.value_or(arrow::util::kUseDefaultCompressionLevel);
+    switch (options.codec) {
+        case CompressionCodec::Uncompressed:
+            break;
+        case CompressionCodec::Lz4: {
+            ARROW_ASSIGN_OR_RAISE(ipc_options.codec, arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME, level));
+            break;
+        }
+        case CompressionCodec::Zstd: {
+            ARROW_ASSIGN_OR_RAISE(ipc_options.codec, arrow::util::Codec::Create(arrow::Compression::ZSTD, level));
+            break;
+        }
+        case CompressionCodec::Snappy:
+            return arrow::Status::NotImplemented("Feather files support the lz4 and zstd codecs, not snappy");
+    }
+    return ipc_options;
+}
+
+arrow::Result<std::unique_ptr<TableFileWriter>> open_table_writer(std::shared_ptr<arrow::io::OutputStream> out,
+                                                                  const std::shared_ptr<arrow::Schema>& schema,
+                                                                  const OutputOptions& options) {
+    if (options.format == OutputFormat::Feather) {
+        ARROW_ASSIGN_OR_RAISE(auto ipc_options, feather_write_options(options));
+        ARROW_ASSIGN_OR_RAISE(auto writer, arrow::ipc::MakeFileWriter(std::move(out), schema, ipc_options));
+        return std::make_unique<FeatherTableWriter>(std::move(writer), options.row_group_size);
+    }
+    ARROW_ASSIGN_OR_RAISE(auto writer, parquet::arrow::FileWriter::Open(*schema, arrow::default_memory_pool(), std::move(out),
+                                                                        writer_properties(*schema, options)));
+    return std::make_unique<ParquetTableWriter>(std::move(writer), options.row_group_size);
+}
+
+} // namespace
+
+CompressionCodec parse_compression_codec(const std::string& name) {
+    if (name == "none" || name == "uncompressed") return CompressionCodec::Uncompressed;
+    if (name == "snappy") return CompressionCodec::Snappy;
+    if (name == "zstd") return CompressionCodec::Zstd;
+    if (name == "lz4") return CompressionCodec::Lz4;
+    throw std::invalid_argument("Unknown codec: " + name);
+}
+
+OutputFormat parse_output_format(const std::string& name) {
+    if (name == "parquet") return OutputFormat::Parquet;
+    if (name == "feather") return OutputFormat::Feather;
+    throw std::invalid_argument("Unknown output format: " + name);
+}
+
+const char* output_format_name(OutputFormat format) {
+    return format == OutputFormat::Feather ? "feather" : "parquet";
+}
+
+std::string table_file_name(const std::string& table, OutputFormat format) {
+    return table + (format == OutputFormat::Feather ? ".feather" : ".parquet");
+}
+
+MatrixLayout parse_matrix_layout(const std::string& name) {
+    if (name == "coo") return MatrixLayout::Coo;
+    if (name == "csc") return MatrixLayout::Csc;
+    if (name == "csr") return MatrixLayout::Csr;
+    throw std::invalid_argument("Unknown matrix layout: " + name);
+}
+
+const char* matrix_layout_name(MatrixLayout layout) {
+    switch (layout) {
+        case MatrixLayout::Csc: return "csc";
+        case MatrixLayout::Csr: return "csr";
+        case MatrixLayout::Coo: break;
+    }
+    return "coo";
+}
+
+std::string matrix_table_name(const std::string& block, MatrixLayout layout) {
+    return "A_" + block + "_" + matrix_layout_name(layout);
+}
+
+std::string output_layout_name(const OutputOptions& options) {
+    std::string name = output_format_name(options.format);
+    if (options.matrix_layout != MatrixLayout::Coo) {
+        name += std::string("-") + matrix_layout_name(options.matrix_layout);
+    }
+    if (options.narrow_indices) {
+        name += "-int32";
     }
+    return name;
+}
 
-    // Convert to COO format if not already
-    Eigen::SparseMatrix<double> coo_mat = matrix;
-    if (matrix.isCompressed()) {
-        coo_mat.makeCompressed();
+std::string conversion_key(const OutputOptions& options, bool streamed) {
+    const char* codec = "none";
+    switch (options.codec) {
+        case CompressionCodec::Snappy: codec = "snappy"; break;
+        case CompressionCodec::Zstd: codec = "zstd"; break;
+        case CompressionCodec::Lz4: codec = "lz4"; break;
+        case CompressionCodec::Uncompressed: break;
     }
+    // concurrent_files only changes how the files are scheduled; source_hash is compared on its own
+    return output_layout_name(options) +
+           ";codec=" + codec +
+           ";level=" + (options.compression_level ? std::to_string(*options.compression_level) : "default") +
+           ";row_group_size=" + std::to_string(options.row_group_size) +
+           ";dictionary=" + (options.parquet.dictionary ? "1" : "0") +
+           ";byte_stream_split=" + (options.parquet.byte_stream_split ? "1" : "0") +
+           ";snapshot=" + (options.snapshot ? "1" : "0") +
+           ";streamed=" + (streamed ? "1" : "0");
+}
 
-    // Create Arrow arrays for row, col, and data
-    arrow::Int64Builder row_builder;
-    arrow::Int64Builder col_builder;
-    arrow::DoubleBuilder data_builder;
+arrow::Status write_table(const arrow::Table& table,
+                          const std::string& filename,
+                          const OutputOptions& options,
+                          SaveFileStats* stats) {
+    if (options.row_group_size <= 0) {
+        return arrow::Status::Invalid("row_group_size must be positive, got ", options.row_group_size);
+    }
+    // Opening the file counts as writing
+    const auto start_time = std::chrono::steady_clock::now();
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::io::OutputStream> outfile,
+                          arrow::io::FileOutputStream::Open(filename));
+    double write_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    if (stats) {
+        outfile = std::make_shared<TimedOutputStream>(std::move(outfile), write_seconds);
+    }
+    ARROW_ASSIGN_OR_RAISE(auto writer, open_table_writer(outfile, table.schema(), options));
+    ARROW_RETURN_NOT_OK(writer->write(table));
+    ARROW_RETURN_NOT_OK(writer->close());
+    ARROW_ASSIGN_OR_RAISE(const int64_t file_bytes, outfile->Tell());
+    ARROW_RETURN_NOT_OK(outfile->Close());
+
+    if (stats) {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        stats->write_seconds += write_seconds;
+        stats->encode_seconds += seconds - write_seconds;
+        stats->bytes += static_cast<size_t>(file_bytes);
+    }
+    return arrow::Status::OK();
+}
 
-    // Reserve space
-    ARROW_RETURN_NOT_OK(row_builder.Reserve(coo_mat.nonZeros()));
-    ARROW_RETURN_NOT_OK(col_builder.Reserve(coo_mat.nonZeros()));
-    ARROW_RETURN_NOT_OK(data_builder.Reserve(coo_mat.nonZeros()));
+namespace {
+
+template <typename ArrowIndex>
+arrow::Status write_coo_matrix(const Eigen::SparseMatrix<double>& matrix,
+                               const std::string& filename,
+                               const OutputOptions& options,
+                               SaveFileStats* stats) {
+    using Index = typename ArrowIndex::c_type;
+
+    // Read the compressed storage directly: column j holds entries [begin, end) of the
+    // inner index (row) and value arrays. Uncompressed matrices have gaps after each column.
+    const int64_t nnz = matrix.nonZeros();
+    const auto* outer = matrix.outerIndexPtr();
+    const auto* inner_nnz = matrix.innerNonZeroPtr();
+    const auto* inner = matrix.innerIndexPtr();
+    const double* values = matrix.valuePtr();
+    const bool compressed = matrix.isCompressed();
+
+    // col expands the outer index. When the storage is compressed, row is the inner index
+    // (wrapped in place if the widths match, as with narrow_indices) and data is wrapped, so
+    // neither is copied; otherwise both are gathered around the gaps.
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> col_buffer, arrow::AllocateBuffer(nnz * sizeof(Index)));
+    std::shared_ptr<arrow::Array> row_array;
+    std::shared_ptr<arrow::Buffer> data_buffer;
+    Index* rows_out = nullptr;
+    double* data_out = nullptr;
+    if (compressed) {
+        ARROW_ASSIGN_OR_RAISE(row_array, index_array<ArrowIndex>(inner, nnz));
+        data_buffer = wrap_buffer(values, nnz * sizeof(double));
+    } else {
+        ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::Buffer> row_buffer, arrow::AllocateBuffer(nnz * sizeof(Index)));
+        ARROW_ASSIGN_OR_RAISE(data_buffer, arrow::AllocateBuffer(nnz * sizeof(double)));
+        rows_out = reinterpret_cast<Index*>(row_buffer->mutable_data());
+        data_out = reinterpret_cast<double*>(data_buffer->mutable_data());
+        row_array = std::make_shared<arrow::NumericArray<ArrowIndex>>(nnz, std::move(row_buffer));
+    }
 
-    // Fill arrays
-    for (int k = 0; k < coo_mat.outerSize(); ++k) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(coo_mat, k); it; ++it) {
-            ARROW_RETURN_NOT_OK(row_builder.Append(it.row()));
-            ARROW_RETURN_NOT_OK(col_builder.Append(it.col()));
-            ARROW_RETURN_NOT_OK(data_builder.Append(it.value()));
+    auto* cols_out = reinterpret_cast<Index*>(col_buffer->mutable_data());
+    if (compressed) {
+        for (int64_t j = 0; j < matrix.outerSize(); ++j) {
+            std::fill(cols_out + outer[j], cols_out + outer[j + 1], static_cast<Index>(j));
+        }
+    } else {
+        int64_t k_out = 0;
+        for (int64_t j = 0; j < matrix.outerSize(); ++j) {
+            const int64_t begin = outer[j];
+            for (int64_t k = begin; k < begin + inner_nnz[j]; ++k, ++k_out) {
+                rows_out[k_out] = inner[k];
+                cols_out[k_out] = static_cast<Index>(j);
+                data_out[k_out] = values[k];
+            }
         }
     }
 
-    // Finish building arrays
-    ARROW_ASSIGN_OR_RAISE(auto row_array, row_builder.Finish());
-    ARROW_ASSIGN_OR_RAISE(auto col_array, col_builder.Finish());
-    ARROW_ASSIGN_OR_RAISE(auto data_array, data_builder.Finish());
+    auto col_array = std::make_shared<arrow::NumericArray<ArrowIndex>>(nnz, col_buffer);
+    auto data_array = std::make_shared<arrow::DoubleArray>(nnz, data_buffer);
 
     // Create table
-    auto schema = arrow::schema({
-        arrow::field("row", arrow::int64()),
-        arrow::field("col", arrow::int64()),
+    auto table = arrow::Table::Make(coo_schema(row_array->type()), {row_array, col_array, data_array});
+
+    // Write to file
+    return write_table(*table, filename, options, stats);
+}
+
+// Writes the compressed storage of a column-major (CSC) or row-major (CSR) matrix:
+// indices and data to filename, the outer offsets to indptr_filename
+template <typename ArrowIndex, typename Matrix>
+arrow::Status write_compressed_storage(const Matrix& matrix,
+                                       const std::string& filename,
+                                       const std::string& indptr_filename,
+                                       const OutputOptions& options,
+                                       SaveFileStats* stats) {
+    const int64_t nnz = matrix.nonZeros();
+    ARROW_ASSIGN_OR_RAISE(auto indices, index_array<ArrowIndex>(matrix.innerIndexPtr(), nnz));
+    ARROW_ASSIGN_OR_RAISE(auto indptr, index_array<ArrowIndex>(matrix.outerIndexPtr(), matrix.outerSize() + 1));
+    auto data = std::make_shared<arrow::DoubleArray>(nnz, wrap_buffer(matrix.valuePtr(), nnz * sizeof(double)));
+
+    auto table = arrow::Table::Make(arrow::schema({
+        arrow::field("indices", indices->type()),
         arrow::field("data", arrow::float64())
-    });
+    }), {indices, data});
+    ARROW_RETURN_NOT_OK(write_table(*table, filename, options, stats));
 
-    auto table = arrow::Table::Make(schema, {row_array, col_array, data_array});
+    auto indptr_table = arrow::Table::Make(arrow::schema({arrow::field("indptr", indptr->type())}), {indptr});
+    return write_table(*indptr_table, indptr_filename, options, stats);
+}
 
-    // Write to Parquet file
-    ARROW_ASSIGN_OR_RAISE(auto outfile, arrow::io::FileOutputStream::Open(filename));
-    
-    PARQUET_THROW_NOT_OK(
-        parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, 1024)
-    );
+template <typename Matrix>
+arrow::Status save_compressed_storage(const Matrix& matrix,
+                                      const std::string& filename,
+                                      const std::string& indptr_filename,
+                                      const OutputOptions& options,
+                                      SaveFileStats* stats) {
+    if (use_int32_indices(options, matrix.rows(), matrix.cols(), matrix.nonZeros())) {
+        return write_compressed_storage<arrow::Int32Type>(matrix, filename, indptr_filename, options, stats);
+    }
+    return write_compressed_storage<arrow::Int64Type>(matrix, filename, indptr_filename, options, stats);
+}
 
-    return arrow::Status::OK();
+} // namespace
+
+// Helper function to save a sparse matrix in COO format (in options.format)
+arrow::Status save_coo_matrix(const Eigen::SparseMatrix<double>& matrix,
+                                           const std::string& filename,
+                                           const OutputOptions& options,
+                                           SaveFileStats* stats) {
+    if (matrix.nonZeros() == 0) {
+        return arrow::Status::OK();
+    }
+    if (use_int32_indices(options, matrix.rows(), matrix.cols(), matrix.nonZeros())) {
+        return write_coo_matrix<arrow::Int32Type>(matrix, filename, options, stats);
+    }
+    return write_coo_matrix<arrow::Int64Type>(matrix, filename, options, stats);
 }
 
-// Helper function to save a vector to parquet
+arrow::Status save_compressed_matrix(const Eigen::SparseMatrix<double>& matrix,
+                                     MatrixLayout layout,
+                                     const std::string& filename,
+                                     const std::string& indptr_filename,
+                                     const OutputOptions& options,
+                                     SaveFileStats* stats) {
+    if (matrix.nonZeros() == 0) {
+        return arrow::Status::OK();
+    }
+    if (layout == MatrixLayout::Csr) {
+        const Eigen::SparseMatrix<double, Eigen::RowMajor> csr = matrix;  // compressed by the conversion
+        return save_compressed_storage(csr, filename, indptr_filename, options, stats);
+    }
+    if (layout != MatrixLayout::Csc) {
+        return arrow::Status::Invalid("save_compressed_matrix writes the CSC and CSR layouts");
+    }
+    if (!matrix.isCompressed()) {
+        Eigen::SparseMatrix<double> csc = matrix;
+        csc.makeCompressed();
+        return save_compressed_storage(csc, filename, indptr_filename, options, stats);
+    }
+    // Eigen's own storage: every array is written without a copy when the index widths match
+    return save_compressed_storage(matrix, filename, indptr_filename, options, stats);
+}
+
+// Helper function to save a vector (in options.format)
 arrow::Status save_vector(const Eigen::VectorXd& vec,
                                        const std::string& name,
-                                       const std::string& filename) {
-    if (vec.size() == 0) {
+                                       const std::string& filename,
+                                       const OutputOptions& options,
+                                       SaveFileStats* stats) {
+    // An empty vector still gets a file, with no rows: a model without variables has an empty c.
+    // The values are written straight from the vector's memory.
+    ARROW_ASSIGN_OR_RAISE(auto array, double_array(vec));
+
+    auto schema = arrow::schema({arrow::field(name, arrow::float64())});
+    auto table = arrow::Table::Make(schema, {array});
+
+    return write_table(*table, filename, options, stats);
+}
+
+// Helper function to save a list of names as a single string column (in options.format)
+arrow::Status save_names(const std::vector<std::string>& names,
+                         const std::string& name,
+                         const std::string& filename,
+                         const OutputOptions& options,
+                         SaveFileStats* stats) {
+    if (names.empty()) {
         return arrow::Status::OK();
     }
 
-    arrow::DoubleBuilder builder;
-    ARROW_RETURN_NOT_OK(builder.Reserve(vec.size()));
-    
-    for (int i = 0; i < vec.size(); ++i) {
-        ARROW_RETURN_NOT_OK(builder.Append(vec[i]));
+    int64_t total_length = 0;
+    for (const auto& value : names) {
+        total_length += static_cast<int64_t>(value.size());
+    }
+    arrow::StringBuilder builder;
+    ARROW_RETURN_NOT_OK(builder.Reserve(static_cast<int64_t>(names.size())));
+    ARROW_RETURN_NOT_OK(builder.ReserveData(total_length));
+    for (const auto& value : names) {
+        ARROW_RETURN_NOT_OK(builder.Append(value));
     }
 
     ARROW_ASSIGN_OR_RAISE(auto array, builder.Finish());
 
-    auto schema = arrow::schema({arrow::field(name, arrow::float64())});
+    auto schema = arrow::schema({arrow::field(name, arrow::utf8())});
     auto table = arrow::Table::Make(schema, {array});
 
-    ARROW_ASSIGN_OR_RAISE(auto outfile, arrow::io::FileOutputStream::Open(filename));
-    
-    PARQUET_THROW_NOT_OK(
-        parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), outfile, 1024)
-    );
+    return write_table(*table, filename, options, stats);
+}
+
+// Helper function to save the variable bounds (lb, ub columns, in options.format)
+arrow::Status save_bounds(const Eigen::VectorXd& lb,
+                          const Eigen::VectorXd& ub,
+                          const std::string& filename,
+                          const OutputOptions& options,
+                          SaveFileStats* stats) {
+    // A model without variables still gets a bounds file, with no rows
+    ARROW_ASSIGN_OR_RAISE(auto lb_array, double_array(lb));
+    ARROW_ASSIGN_OR_RAISE(auto ub_array, double_array(ub));
 
-    return arrow::Status::OK();
+    auto bounds_schema = arrow::schema({
+        arrow::field("lb", arrow::float64()),
+        arrow::field("ub", arrow::float64())
+    });
+    auto bounds_table = arrow::Table::Make(bounds_schema, {lb_array, ub_array});
+
+    return write_table(*bounds_table, filename, options, stats);
 }
 
-std::tuple<std::string, double> save_lp_to_parquet(const LpData& lp_data,
-                                                  const std::string& instance_name) {
-    auto start_time = std::chrono::high_resolution_clock::now();
+std::string parquet_output_dir(const std::string& instance_name) {
+    return (fs::path("data") / (instance_name + "_parquet")).string();
+}
 
-    // Create output directory
-    fs::path base_data_dir("data");
-    fs::path output_dir = base_data_dir / (instance_name + "_parquet");
-    fs::create_directories(output_dir);
+namespace {
+
+// Stats of the COO files written while parsing, by file name
+using StreamedFiles = std::vector<std::pair<std::string, SaveFileStats>>;
+
+// COO matrix file written incrementally: entries are buffered and encoded as a row group
+// (record batch for Feather) every row_group_size entries. The file is created with the first row group, so a block
+// without entries leaves no file, as with save_coo_matrix.
+class CooStreamFile {
+public:
+    CooStreamFile(fs::path path, const OutputOptions& options)
+        : path_(std::move(path)), options_(options),
+          capacity_(static_cast<size_t>(std::max<int64_t>(1, options.row_group_size))) {}
+
+    arrow::Status append(int row, int col, double value) {
+        rows_.push_back(row);
+        cols_.push_back(col);
+        values_.push_back(value);
+        return rows_.size() == capacity_ ? flush() : arrow::Status::OK();
+    }
+
+    // Writes the last row group and the footer
+    arrow::Status close() {
+        ARROW_RETURN_NOT_OK(flush());
+        if (!writer_) {
+            return arrow::Status::OK();
+        }
+        const auto start_time = std::chrono::steady_clock::now();
+        ARROW_RETURN_NOT_OK(writer_->close());
+        ARROW_ASSIGN_OR_RAISE(const int64_t file_bytes, out_->Tell());
+        ARROW_RETURN_NOT_OK(out_->Close());
+        busy_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+        stats_.seconds = busy_seconds_;
+        stats_.write_seconds = write_seconds_;
+        stats_.encode_seconds = busy_seconds_ - write_seconds_;
+        stats_.bytes = static_cast<size_t>(file_bytes);
+        return arrow::Status::OK();
+    }
 
-    std::cout << "Saving data to directory: " << output_dir << std::endl;
+    bool written() const { return writer_ != nullptr; }
+    const SaveFileStats& stats() const { return stats_; }
 
-    // Save vectors
-    auto c_result = save_vector(lp_data.get_c(), "c", 
-                              (output_dir / "c.parquet").string());
-    if (!c_result.ok()) {
-        throw std::runtime_error("Failed to save c vector: " + c_result.ToString());
+private:
+    arrow::Status flush() {
+        if (rows_.empty()) {
+            return arrow::Status::OK();
+        }
+        const auto start_time = std::chrono::steady_clock::now();
+        if (!writer_) {
+            ARROW_ASSIGN_OR_RAISE(std::shared_ptr<arrow::io::OutputStream> file,
+                                  arrow::io::FileOutputStream::Open(path_.string()));
+            write_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            out_ = std::make_shared<TimedOutputStream>(std::move(file), write_seconds_);
+            ARROW_ASSIGN_OR_RAISE(writer_, open_table_writer(out_, coo_schema(index_type()), options_));
+        }
+
+        // The buffers are encoded before the write returns, so they can be wrapped and reused
+        const int64_t n = static_cast<int64_t>(rows_.size());
+        std::shared_ptr<arrow::Array> rows, cols;
+        if (options_.narrow_indices) {
+            ARROW_ASSIGN_OR_RAISE(rows, index_array<arrow::Int32Type>(rows_.data(), n));
+            ARROW_ASSIGN_OR_RAISE(cols, index_array<arrow::Int32Type>(cols_.data(), n));
+        } else {
+            ARROW_ASSIGN_OR_RAISE(rows, index_array<arrow::Int64Type>(rows_.data(), n));
+            ARROW_ASSIGN_OR_RAISE(cols, index_array<arrow::Int64Type>(cols_.data(), n));
+        }
+        auto table = arrow::Table::Make(coo_schema(index_type()), {
+            rows, cols, std::make_shared<arrow::DoubleArray>(n, wrap_buffer(values_.data(), n * sizeof(double)))
+        });
+        ARROW_RETURN_NOT_OK(writer_->write(*table));
+        rows_.clear();
+        cols_.clear();
+        values_.clear();
+        busy_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        return arrow::Status::OK();
     }
 
-    // Save bounds
-    arrow::DoubleBuilder lb_builder, ub_builder;
-    const auto& lb = lp_data.get_lb();
-    const auto& ub = lp_data.get_ub();
-    
-    PARQUET_THROW_NOT_OK(lb_builder.Reserve(lb.size()));
-    PARQUET_THROW_NOT_OK(ub_builder.Reserve(ub.size()));
-    
-    for (int i = 0; i < lb.size(); ++i) {
-        PARQUET_THROW_NOT_OK(lb_builder.Append(lb[i]));
-        PARQUET_THROW_NOT_OK(ub_builder.Append(ub[i]));
+    // Row positions and column ids are ints, so int32 always fits
+    std::shared_ptr<arrow::DataType> index_type() const {
+        return options_.narrow_indices ? arrow::int32() : arrow::int64();
     }
 
-    auto lb_result = lb_builder.Finish();
-    auto ub_result = ub_builder.Finish();
-    if (!lb_result.ok() || !ub_result.ok()) {
-        throw std::runtime_error("Failed to build bounds arrays");
+    fs::path path_;
+    const OutputOptions& options_;
+    size_t capacity_;
+    std::vector<int> rows_;
+    std::vector<int> cols_;
+    std::vector<double> values_;
+    std::shared_ptr<arrow::io::OutputStream> out_;
+    std::unique_ptr<TableFileWriter> writer_;
+    double write_seconds_ = 0.0;  // updated by out_
+    double busy_seconds_ = 0.0;
+    SaveFileStats stats_;
+};
+
+// Sorts each parsed column into A_eq / A_ineq positions (the row order build_matrices
+// uses: E rows for A_eq; L rows, then G rows negated, for A_ineq) and streams it out
+class CooStreamSink : public CoefficientSink {
+public:
+    CooStreamSink(const fs::path& output_dir, const OutputOptions& options)
+        : eq_file_(table_file_name(matrix_table_name("eq", MatrixLayout::Coo), options.format)),
+          ineq_file_(table_file_name(matrix_table_name("ineq", MatrixLayout::Coo), options.format)),
+          eq_(output_dir / eq_file_, options), ineq_(output_dir / ineq_file_, options) {}
+
+    void add_column(const ParserState& state, int col, const int* rows, const double* values,
+                    size_t count) override {
+        if (row_position_.size() != static_cast<size_t>(state.get_num_rows())) {
+            map_rows(state);
+        }
+        if (col < last_col_ && !warned_) {
+            log_message(LogLevel::Warning, "Column ", state.get_col_name(col),
+                        " appears again later in COLUMNS; its new entries are appended to the COO files");
+            warned_ = true;
+        }
+        last_col_ = std::max(last_col_, col);
+
+        eq_entries_.clear();
+        ineq_entries_.clear();
+        for (size_t k = 0; k < count; ++k) {
+            const int position = row_position_[rows[k]];
+            if (position < 0) continue;  // objective or extra N row
+            switch (row_block_[rows[k]]) {
+                case 'E': eq_entries_.emplace_back(position, values[k]); break;
+                case 'L': ineq_entries_.emplace_back(position, values[k]); break;
+                default: ineq_entries_.emplace_back(position, -values[k]); break;
+            }
+        }
+        append(eq_, eq_entries_, col);
+        append(ineq_, ineq_entries_, col);
     }
 
-    auto bounds_schema = arrow::schema({
-        arrow::field("lb", arrow::float64()),
-        arrow::field("ub", arrow::float64())
-    });
-    auto bounds_table = arrow::Table::Make(bounds_schema, {*lb_result, *ub_result});
+    // Closes both files; returns the stats of those that were written
+    StreamedFiles close() {
+        check(eq_.close(), "Failed to save A_eq matrix: ");
+        check(ineq_.close(), "Failed to save A_ineq matrix: ");
+        StreamedFiles files;
+        if (eq_.written()) files.emplace_back(eq_file_, eq_.stats());
+        if (ineq_.written()) files.emplace_back(ineq_file_, ineq_.stats());
+        return files;
+    }
 
-    auto bounds_file_result = arrow::io::FileOutputStream::Open((output_dir / "bounds.parquet").string());
-    if (!bounds_file_result.ok()) {
-        throw std::runtime_error("Failed to create bounds file: " + bounds_file_result.status().ToString());
+private:
+    void map_rows(const ParserState& state) {
+        const int n_rows = state.get_num_rows();
+        row_position_.assign(n_rows, -1);
+        row_block_.assign(n_rows, 'N');
+        int n_eq = 0, n_le = 0;
+        for (int i = 0; i < n_rows; ++i) {
+            if (i == state.get_objective_row()) continue;
+            const char type = state.get_row_type(i);
+            if (type == 'E') {
+                row_position_[i] = n_eq++;
+            } else if (type == 'L') {
+                row_position_[i] = n_le++;
+            }
+            row_block_[i] = type;
+        }
+        int n_ge = 0;
+        for (int i = 0; i < n_rows; ++i) {
+            if (i != state.get_objective_row() && state.get_row_type(i) == 'G') {
+                row_position_[i] = n_le + n_ge++;
+            }
+        }
     }
 
-    PARQUET_THROW_NOT_OK(
-        parquet::arrow::WriteTable(*bounds_table, arrow::default_memory_pool(), *bounds_file_result, 1024)
-    );
+    void append(CooStreamFile& file, std::vector<std::pair<int, double>>& entries, int col) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (const auto& [position, value] : entries) {
+            check(file.append(position, col, value),
+                  &file == &eq_ ? "Failed to save A_eq matrix: " : "Failed to save A_ineq matrix: ");
+        }
+    }
 
-    // Save equality constraints
-    if (lp_data.get_b_eq().size() > 0) {
-        auto b_eq_result = save_vector(lp_data.get_b_eq(), "b_eq",
-                                     (output_dir / "b_eq.parquet").string());
-        if (!b_eq_result.ok()) {
-            throw std::runtime_error("Failed to save b_eq vector: " + b_eq_result.ToString());
+    static void check(const arrow::Status& status, const char* error_prefix) {
+        if (!status.ok()) {
+            throw std::runtime_error(error_prefix + status.ToString());
         }
+    }
+
+    std::string eq_file_;
+    std::string ineq_file_;
+    CooStreamFile eq_;
+    CooStreamFile ineq_;
+    std::vector<int> row_position_;  // position within the row's block, -1 if in neither matrix
+    std::vector<char> row_block_;    // row type
+    std::vector<std::pair<int, double>> eq_entries_;
+    std::vector<std::pair<int, double>> ineq_entries_;
+    int last_col_ = -1;
+    bool warned_ = false;
+};
+
+// Writes a constraint block in options.matrix_layout; the indptr file of a compressed
+// layout sits next to filename and is counted in the same stats
+arrow::Status save_matrix(const Eigen::SparseMatrix<double>& matrix, const std::string& block,
+                          const std::string& filename, const OutputOptions& options, SaveFileStats* stats) {
+    if (options.matrix_layout == MatrixLayout::Coo) {
+        return save_coo_matrix(matrix, filename, options, stats);
+    }
+    const std::string indptr_name = table_file_name(matrix_table_name(block, options.matrix_layout) + "_indptr",
+                                                    options.format);
+    return save_compressed_matrix(matrix, options.matrix_layout, filename,
+                                  (fs::path(filename).parent_path() / indptr_name).string(), options, stats);
+}
 
-        auto A_eq_result = save_coo_matrix(lp_data.get_A_eq(),
-                                         (output_dir / "A_eq_coo.parquet").string());
-        if (!A_eq_result.ok()) {
-            throw std::runtime_error("Failed to save A_eq matrix: " + A_eq_result.ToString());
+// One output file of save_lp_to_parquet
+struct SaveTask {
+    std::string file_name;
+    std::string error_prefix;
+    std::function<arrow::Status(const std::string&, SaveFileStats*)> write;
+    arrow::Status status;
+    SaveFileStats stats;
+};
+
+void run_save_task(SaveTask& task, const fs::path& output_dir) {
+    const auto start_time = std::chrono::steady_clock::now();
+    try {
+        task.status = task.write((output_dir / task.file_name).string(), &task.stats);
+    } catch (const std::exception& e) {
+        // Parquet reports some failures by throwing
+        task.status = arrow::Status::IOError(e.what());
+    }
+    task.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+// Prepares an instance directory for a rewrite
+fs::path prepare_output_dir(const std::string& instance_name, const OutputOptions& options) {
+    // Reject settings the writers cannot use before touching the directory
+    if (options.row_group_size <= 0) {
+        throw std::invalid_argument("row_group_size must be positive, got " + std::to_string(options.row_group_size));
+    }
+    if (options.format == OutputFormat::Feather) {
+        auto ipc_options = feather_write_options(options);
+        if (!ipc_options.ok()) {
+            throw std::invalid_argument(ipc_options.status().message());
         }
     }
 
-    // Save inequality constraints
+    fs::path output_dir = parquet_output_dir(instance_name);
+    fs::create_directories(output_dir);
+
+    // metadata.json is written last; drop a stale one first so an interrupted
+    // rewrite is never mistaken for a cached conversion
+    fs::remove(output_dir / "metadata.json");
+    if (!options.snapshot) {
+        fs::remove(output_dir / kSnapshotFileName);  // would describe an older model
+    }
+    // So would tables left in the other format, and matrix files of any layout: only the
+    // blocks with nonzeros are rewritten. Names and right-hand sides are only written when
+    // non-empty, so they go in either format.
+    const OutputFormat other = options.format == OutputFormat::Parquet ? OutputFormat::Feather : OutputFormat::Parquet;
+    for (const char* table : {"c", "bounds"}) {
+        fs::remove(output_dir / table_file_name(table, other));
+    }
+    for (OutputFormat format : {OutputFormat::Parquet, OutputFormat::Feather}) {
+        for (const char* table : {"col_names", "b_eq", "b_ineq"}) {
+            fs::remove(output_dir / table_file_name(table, format));
+        }
+        for (MatrixLayout layout : {MatrixLayout::Coo, MatrixLayout::Csc, MatrixLayout::Csr}) {
+            for (const char* block : {"eq", "ineq"}) {
+                fs::remove(output_dir / table_file_name(matrix_table_name(block, layout), format));
+                fs::remove(output_dir / table_file_name(matrix_table_name(block, layout) + "_indptr", format));
+            }
+        }
+    }
+    return output_dir;
+}
+
+// Writes the files of lp_data and then metadata.json. If streamed is set, the COO
+// matrix files were already written while parsing and only their stats are recorded.
+// Returns the save time measured from start_time.
+double save_instance_files(const LpData& lp_data,
+                           const fs::path& output_dir,
+                           const OutputOptions& options,
+                           std::chrono::high_resolution_clock::time_point start_time,
+                           const StreamedFiles* streamed) {
+    log_message(LogLevel::Debug, "Saving data to directory: ", output_dir.string());
+
+    // The files are independent: vectors, bounds, and the constraint blocks that exist
+    std::vector<SaveTask> tasks;
+    tasks.push_back({table_file_name("c", options.format), "Failed to save c vector: ", [&](const std::string& filename, SaveFileStats* stats) {
+        return save_vector(lp_data.get_c(), "c", filename, options, stats);
+    }});
+    tasks.push_back({table_file_name("bounds", options.format), "Failed to save bounds: ", [&](const std::string& filename, SaveFileStats* stats) {
+        return save_bounds(lp_data.get_lb(), lp_data.get_ub(), filename, options, stats);
+    }});
+    tasks.push_back({table_file_name("col_names", options.format), "Failed to save column names: ", [&](const std::string& filename, SaveFileStats* stats) {
+        return save_names(lp_data.get_col_names(), "name", filename, options, stats);
+    }});
+    if (lp_data.get_b_eq().size() > 0) {
+        tasks.push_back({table_file_name("b_eq", options.format), "Failed to save b_eq vector: ", [&](const std::string& filename, SaveFileStats* stats) {
+            return save_vector(lp_data.get_b_eq(), "b_eq", filename, options, stats);
+        }});
+    }
+    if (lp_data.get_b_eq().size() > 0 && !streamed) {
+        tasks.push_back({table_file_name(matrix_table_name("eq", options.matrix_layout), options.format),
+                         "Failed to save A_eq matrix: ", [&](const std::string& filename, SaveFileStats* stats) {
+            return save_matrix(lp_data.get_A_eq(), "eq", filename, options, stats);
+        }});
+    }
     if (lp_data.get_b_ineq().size() > 0) {
-        auto b_ineq_result = save_vector(lp_data.get_b_ineq(), "b_ineq",
-                                       (output_dir / "b_ineq.parquet").string());
-        if (!b_ineq_result.ok()) {
-            throw std::runtime_error("Failed to save b_ineq vector: " + b_ineq_result.ToString());
+        tasks.push_back({table_file_name("b_ineq", options.format), "Failed to save b_ineq vector: ", [&](const std::string& filename, SaveFileStats* stats) {
+            return save_vector(lp_data.get_b_ineq(), "b_ineq", filename, options, stats);
+        }});
+    }
+    if (lp_data.get_b_ineq().size() > 0 && !streamed) {
+        tasks.push_back({table_file_name(matrix_table_name("ineq", options.matrix_layout), options.format),
+                         "Failed to save A_ineq matrix: ", [&](const std::string& filename, SaveFileStats* stats) {
+            return save_matrix(lp_data.get_A_ineq(), "ineq", filename, options, stats);
+        }});
+    }
+
+    if (options.snapshot) {
+        tasks.push_back({kSnapshotFileName, "Failed to save snapshot: ", [&](const std::string& filename, SaveFileStats* stats) {
+            const auto start_time = std::chrono::steady_clock::now();
+            stats->bytes = save_lp_snapshot(lp_data, filename);
+            stats->write_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            return arrow::Status::OK();
+        }});
+    }
+
+    if (options.concurrent_files) {
+        // One task per file; the two COO files dominate, so more threads would not help
+        std::vector<std::future<void>> pending;
+        for (auto& task : tasks) {
+            pending.push_back(std::async(std::launch::async, run_save_task, std::ref(task), std::cref(output_dir)));
         }
+        for (auto& future : pending) {
+            future.get();
+        }
+    } else {
+        for (auto& task : tasks) {
+            run_save_task(task, output_dir);
+            if (!task.status.ok()) break;
+        }
+    }
 
-        auto A_ineq_result = save_coo_matrix(lp_data.get_A_ineq(),
-                                           (output_dir / "A_ineq_coo.parquet").string());
-        if (!A_ineq_result.ok()) {
-            throw std::runtime_error("Failed to save A_ineq matrix: " + A_ineq_result.ToString());
+    json file_stats = json::object();
+    for (const auto& task : tasks) {
+        if (!task.status.ok()) {
+            throw std::runtime_error(task.error_prefix + task.status.ToString());
+        }
+        file_stats[task.file_name] = task.stats;
+    }
+    if (streamed) {
+        for (const auto& [file_name, stats] : *streamed) {
+            file_stats[file_name] = stats;
         }
     }
 
-    // Calculate save time
+    // Calculate save time (wall time, so concurrent writes are not summed)
     auto end_time = std::chrono::high_resolution_clock::now();
     double save_parquet_time = std::chrono::duration<double>(end_time - start_time).count();
 
-    std::cout << "Finished saving to Parquet in " << save_parquet_time << " seconds" << std::endl;
+    log_message(LogLevel::Debug, "Finished saving to Parquet in ", save_parquet_time, " seconds");
 
     // Save metadata
     json metadata = {
         {"n_vars", lp_data.get_n_vars()},
         {"obj_offset", lp_data.get_obj_offset()},
         {"parse_time_seconds", lp_data.get_parse_time_seconds()},
-        {"save_parquet_time_seconds", save_parquet_time}
+        {"save_parquet_time_seconds", save_parquet_time},
+        {"output_format", output_format_name(options.format)},
+        {"output_layout", output_layout_name(options)},
+        {"conversion_key", conversion_key(options, streamed != nullptr)},
+        {"matrix_layout", matrix_layout_name(options.matrix_layout)},
+        {"save_concurrent_files", options.concurrent_files},
+        {"save_streamed_matrices", streamed != nullptr},
+        {"save_files", file_stats},
+        {"parse_stats", lp_data.get_parse_stats()},
+        {"converter_version", kConverterVersion}
     };
+    if (!options.source_hash.empty()) {
+        metadata["source_hash"] = options.source_hash;
+    }
 
     std::ofstream metadata_file(output_dir / "metadata.json");
     metadata_file << metadata.dump(4);
     metadata_file.close();
 
+    return save_parquet_time;
+}
+
+} // namespace
+
+std::tuple<std::string, double> save_lp_to_parquet(const LpData& lp_data,
+                                                  const std::string& instance_name,
+                                                  const OutputOptions& options) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    fs::path output_dir = prepare_output_dir(instance_name, options);
+    double save_parquet_time = save_instance_files(lp_data, output_dir, options, start_time, nullptr);
     return {output_dir.string(), save_parquet_time};
 }
 
-} // namespace mps 
\ No newline at end of file
+std::tuple<std::string, double> stream_mps_to_parquet(const std::string& mps_path,
+                                                     const std::string& instance_name,
+                                                     const ParseOptions& parse_options,
+                                                     const OutputOptions& options) {
+    if (options.snapshot) {
+        throw std::invalid_argument("A snapshot needs the full matrices; use parse_mps and save_lp_to_parquet");
+    }
+    if (options.matrix_layout != MatrixLayout::Coo) {
+        throw std::invalid_argument("Streamed matrices are written in the COO layout only");
+    }
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    fs::path output_dir = prepare_output_dir(instance_name, options);
+
+    CooStreamSink sink(output_dir, options);
+    ParseOptions streaming = parse_options;
+    streaming.coefficient_sink = &sink;
+    auto lp_data = parse_mps(mps_path, streaming);
+
+    // The writes made during the parse are in its read time already, so the save clock
+    // starts here: parse_time_seconds + save_parquet_time_seconds add up to the total
+    const auto save_start_time = std::chrono::high_resolution_clock::now();
+    const StreamedFiles streamed = sink.close();
+    save_instance_files(*lp_data, output_dir, options, save_start_time, &streamed);
+    double total_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    return {output_dir.string(), total_time};
+}
+
+} // namespace mps
@@ -2,6 +2,8 @@
 #define PARQUET_WRITER_H
 
 #include "lp_data.h"
+#include "mps_parser.h"
+#include "parse_stats.h"
 #include <arrow/api.h>
 #include <arrow/io/api.h>
 #include <arrow/result.h>
@@ -9,22 +11,161 @@
 #include <string>
 #include <chrono>
 #include <filesystem>
+#include <optional>
 #include <tuple>
 
 namespace mps {
 
-// Helper function to save a sparse matrix in COO format to parquet
+// Compression codec for Parquet column chunks and Feather record batch buffers
+enum class CompressionCodec { Uncompressed, Snappy, Zstd, Lz4 };
+
+// File format of the tables of an instance; both hold the same columns
+enum class OutputFormat {
+    Parquet,  // encoded column chunks: compact, but decoded on every load
+    Feather   // Arrow IPC file (Feather v2): memory-mapped without decoding when uncompressed
+};
+
+// On-disk layout of the constraint matrices A_eq and A_ineq
+enum class MatrixLayout {
+    Coo,  // A_*_coo: row, col, data per nonzero
+    Csc,  // A_*_csc: indices (row), data per nonzero; A_*_csc_indptr: cols + 1 offsets (scipy csc_matrix)
+    Csr   // A_*_csr: indices (col), data per nonzero; A_*_csr_indptr: rows + 1 offsets (scipy csr_matrix)
+};
+
+// Encodings only the Parquet writer applies; Feather files ignore them
+struct ParquetEncoding {
+    bool dictionary = true;                     // dictionary-encode columns
+    bool byte_stream_split = false;             // BYTE_STREAM_SPLIT encoding for float64 columns
+};
+
+// Output settings shared by every file of an instance, in either format
+struct OutputOptions {
+    OutputFormat format = OutputFormat::Parquet;
+    int64_t row_group_size = 1 << 20;           // rows per Parquet row group or Feather record batch
+    CompressionCodec codec = CompressionCodec::Uncompressed; // Feather takes none, zstd or lz4
+    std::optional<int> compression_level;       // codec default when unset
+    ParquetEncoding parquet;
+    MatrixLayout matrix_layout = MatrixLayout::Coo; // save_lp_to_parquet: layout of A_eq and A_ineq
+    bool narrow_indices = false;                // int32 index columns when the matrix dimensions and nnz fit
+    bool concurrent_files = false;              // save_lp_to_parquet: write the files in parallel
+    bool snapshot = false;                      // save_lp_to_parquet: also write a native snapshot (lp_snapshot.h)
+    std::string source_hash;                    // save_lp_to_parquet: recorded for the conversion cache if set
+};
+
+// Parses a codec name ("none", "snappy", "zstd", "lz4"); throws std::invalid_argument otherwise
+CompressionCodec parse_compression_codec(const std::string& name);
+
+// Parses a format name ("parquet", "feather"); throws std::invalid_argument otherwise
+OutputFormat parse_output_format(const std::string& name);
+
+// Name of a format as recorded in metadata.json ("parquet", "feather")
+const char* output_format_name(OutputFormat format);
+
+// File name of a table in an instance directory, e.g. "A_eq_coo.parquet" or "A_eq_coo.feather"
+std::string table_file_name(const std::string& table, OutputFormat format);
+
+// Parses a layout name ("coo", "csc", "csr"); throws std::invalid_argument otherwise
+MatrixLayout parse_matrix_layout(const std::string& name);
+
+// Name of a layout as recorded in metadata.json ("coo", "csc", "csr")
+const char* matrix_layout_name(MatrixLayout layout);
+
+// Table holding the entries of a constraint block ("eq" or "ineq"), e.g. "A_eq_csc";
+// the compressed layouts keep their offsets in the table of that name plus "_indptr"
+std::string matrix_table_name(const std::string& block, MatrixLayout layout);
+
+// Format, matrix layout and index width as one name: "parquet" for the defaults,
+// otherwise e.g. "feather-csc-int32". Recorded in metadata.json as output_layout; it
+// leaves out the encoding settings, which conversion_key() adds for the cache.
+std::string output_layout_name(const OutputOptions& options);
+
+// Every setting that changes the files written, including the encoding and whether the
+// matrices were streamed (stream_mps_to_parquet), e.g.
+// "parquet;codec=zstd;level=default;row_group_size=1048576;dictionary=1;...".
+// Recorded in metadata.json and compared by the conversion cache.
+std::string conversion_key(const OutputOptions& options, bool streamed = false);
+
+// Writes a table to a file in options.format, in chunks of row_group_size rows
+// (Parquet row groups or IPC record batches). If stats is set, the encode and write
+// times and the file size are added to it.
+arrow::Status write_table(const arrow::Table& table,
+                          const std::string& filename,
+                          const OutputOptions& options = OutputOptions(),
+                          SaveFileStats* stats = nullptr);
+
+// Helper function to save a sparse matrix in COO format (in options.format)
 arrow::Status save_coo_matrix(const Eigen::SparseMatrix<double>& matrix,
-                                           const std::string& filename);
+                                           const std::string& filename,
+                                           const OutputOptions& options = OutputOptions(),
+                                           SaveFileStats* stats = nullptr);
 
-// Helper function to save a vector to parquet
+// Saves a sparse matrix in the CSC or CSR layout (in options.format): indices and data
+// to filename, the outer offsets (indptr) to indptr_filename. CSC writes Eigen's compressed
+// storage as-is; CSR converts it first. Nothing is written for a matrix without nonzeros.
+arrow::Status save_compressed_matrix(const Eigen::SparseMatrix<double>& matrix,
+                                     MatrixLayout layout,
+                                     const std::string& filename,
+                                     const std::string& indptr_filename,
+                                     const OutputOptions& options = OutputOptions(),
+                                     SaveFileStats* stats = nullptr);
+
+// Helper function to save a vector (in options.format); an empty vector gives a table without rows
 arrow::Status save_vector(const Eigen::VectorXd& vec,
                                        const std::string& name,
-                                       const std::string& filename);
+                                       const std::string& filename,
+                                       const OutputOptions& options = OutputOptions(),
+                                       SaveFileStats* stats = nullptr);
+
+// Helper function to save a list of names as a single string column (in options.format).
+// Nothing is written for an empty list.
+arrow::Status save_names(const std::vector<std::string>& names,
+                         const std::string& name,
+                         const std::string& filename,
+                         const OutputOptions& options = OutputOptions(),
+                         SaveFileStats* stats = nullptr);
+
+// Helper function to save the variable bounds (lb, ub columns, in options.format)
+arrow::Status save_bounds(const Eigen::VectorXd& lb,
+                          const Eigen::VectorXd& ub,
+                          const std::string& filename,
+                          const OutputOptions& options = OutputOptions(),
+                          SaveFileStats* stats = nullptr);
 
-// Function to save LpData to parquet files
+// Directory save_lp_to_parquet writes an instance to: data/<instance_name>_parquet
+std::string parquet_output_dir(const std::string& instance_name);
+
+// Function to save LpData to parquet files (or Feather files, see options.format).
+// metadata.json records the output format, the total wall time, the time spent on each
+// file (split into encoding and writing), the model's ParseStats, and the converter
+// version and source hash used by the conversion cache.
 // Returns {output_directory_path, save_time_in_seconds}
-std::tuple<std::string, double> save_lp_to_parquet(const LpData& lp_data, const std::string& instance_name);
+std::tuple<std::string, double> save_lp_to_parquet(const LpData& lp_data, const std::string& instance_name,
+                                                   const OutputOptions& options = OutputOptions());
+
+/**
+ * Converts an MPS file to the layout of save_lp_to_parquet without building the constraint
+ * matrices: each column's coefficients are handed to the COO files as soon as the column
+ * ends, and a row group is encoded and written whenever row_group_size entries are pending.
+ * Memory for the nonzeros is bounded by two row groups; the vectors and names are written
+ * after parsing, and metadata.json last. Entries are in column order, rows sorted within a
+ * column, as save_coo_matrix writes them. A column that reappears later in COLUMNS has its
+ * new entries appended, so a (row, col) pair repeated across the two runs is stored twice;
+ * load_lp_from_parquet keeps the later one, as parse_mps does.
+ * parse_options.coefficient_sink is replaced; the ParseStats in metadata.json count the
+ * matrix writes made while parsing as read time, so save_parquet_time_seconds only covers
+ * the work after the parse (the last row groups, the vectors and metadata.json).
+ * save_files holds the stats of the streamed files too, with all of their write time.
+ * options.narrow_indices applies; the layout is always COO, since entries of a reappearing
+ * column arrive out of column order.
+ * @throws std::invalid_argument if options.snapshot is set (a snapshot needs the matrices)
+ *         or options.matrix_layout is not Coo
+ * @throws std::runtime_error on parse or write errors
+ * @return {output_directory_path, total time in seconds (parsing and saving)}
+ */
+std::tuple<std::string, double> stream_mps_to_parquet(const std::string& mps_path,
+                                                     const std::string& instance_name,
+                                                     const ParseOptions& parse_options = ParseOptions(),
+                                                     const OutputOptions& options = OutputOptions());
 
 } // namespace mps
 
@@ -5,17 +5,91 @@
 #include <filesystem>
 #include "mps_parser.h"
 #include "parquet_writer.h"
+#include "cli_args.h"
+#include "compressed_input.h"
+#include "conversion_cache.h"
+#include "log.h"
+#include "lp_snapshot.h"
 #include "lp_data.h" // Include LpData definition
 
 namespace fs = std::filesystem;
 
+static void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--reader stream|mmap] [--threads N] [--presize] [--codec none|snappy|zstd|lz4]"
+              << " [--format parquet|feather] [--layout coo|csc|csr] [--int32-indices]"
+              << " [--row-group-size ROWS] [--concurrent-save] [--snapshot] [--stream] [--no-cache] <path_to_mps_file>" << std::endl;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <path_to_mps_file>" << std::endl;
+    mps::ParseOptions parse_options;
+    mps::OutputOptions write_options;
+    std::string mps_file_path;
+    bool use_cache = true;
+    bool stream = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--reader" && i + 1 < argc) {
+                std::string backend = argv[++i];
+                if (backend == "stream") {
+                    parse_options.backend = mps::ReaderBackend::Stream;
+                } else if (backend == "mmap") {
+                    parse_options.backend = mps::ReaderBackend::Mmap;
+                } else {
+                    throw std::invalid_argument("Unknown reader backend: " + backend);
+                }
+            } else if (arg == "--threads" && i + 1 < argc) {
+                parse_options.num_threads = mps::parse_int_option(arg, argv[++i], 0);
+            } else if (arg == "--presize") {
+                parse_options.presize = true;
+            } else if (arg == "--codec" && i + 1 < argc) {
+                write_options.codec = mps::parse_compression_codec(argv[++i]);
+            } else if (arg == "--format" && i + 1 < argc) {
+                write_options.format = mps::parse_output_format(argv[++i]);
+            } else if (arg == "--layout" && i + 1 < argc) {
+                write_options.matrix_layout = mps::parse_matrix_layout(argv[++i]);
+            } else if (arg == "--int32-indices") {
+                write_options.narrow_indices = true;
+            } else if (arg == "--row-group-size" && i + 1 < argc) {
+                write_options.row_group_size = mps::parse_int_option<int64_t>(arg, argv[++i], 1);
+            } else if (arg == "--concurrent-save") {
+                write_options.concurrent_files = true;
+            } else if (arg == "--snapshot") {
+                write_options.snapshot = true;
+            } else if (arg == "--stream") {
+                stream = true;
+            } else if (arg == "--no-cache") {
+                use_cache = false;
+            } else if (mps_file_path.empty() && arg.rfind("--", 0) != 0) {
+                mps_file_path = arg;
+            } else if (arg.rfind("--", 0) != 0) {
+                throw std::invalid_argument("Only one MPS file can be given, got " + mps_file_path + " and " + arg);
+            } else {
+                throw std::invalid_argument("Unknown option or missing value: " + arg);
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        print_usage(argv[0]);
         return 1;
     }
 
-    std::string mps_file_path = argv[1];
+    if (mps_file_path.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (stream && write_options.snapshot) {
+        std::cerr << "Error: --stream cannot write a snapshot (it never builds the matrices)" << std::endl;
+        return 1;
+    }
+    if (stream && write_options.matrix_layout != mps::MatrixLayout::Coo) {
+        std::cerr << "Error: --stream writes the coo layout only" << std::endl;
+        return 1;
+    }
+
+    // Every library message, phase timings included
+    mps::set_log_sink(mps::stream_log_sink(std::cout), mps::LogLevel::Debug);
 
     // Check if file exists
     if (!fs::exists(mps_file_path)) {
@@ -24,10 +98,35 @@ int main(int argc, char* argv[]) {
     }
 
     try {
+        // Extract instance name from file path
+        std::string instance_name = mps::instance_name_from_path(mps_file_path);
+
+        // Skip the conversion if the output was written from identical input by this version.
+        // The hash is recorded even with --no-cache so the next run can hit.
+        write_options.source_hash = mps::hash_file(mps_file_path);
+        const std::string cached_dir = mps::parquet_output_dir(instance_name);
+        const bool snapshot_ok = !write_options.snapshot || fs::exists(fs::path(cached_dir) / mps::kSnapshotFileName);
+        const bool cached = mps::is_cached_conversion(cached_dir, write_options.source_hash,
+                                                      mps::conversion_key(write_options, stream));
+        if (use_cache && snapshot_ok && cached) {
+            std::cout << "Up to date (source hash " << write_options.source_hash << "): " << cached_dir << std::endl;
+            return 0;
+        }
+
+        if (stream) {
+            // Matrix entries go to the COO files while parsing; only the vectors stay in memory
+            std::cout << "Streaming MPS file to Parquet: " << mps_file_path << std::endl;
+            auto [output_dir, total_time] = mps::stream_mps_to_parquet(mps_file_path, instance_name,
+                                                                       parse_options, write_options);
+            std::cout << "\nSuccessfully saved data to: " << output_dir << std::endl;
+            std::cout << "Parse and save time: " << total_time << " seconds" << std::endl;
+            return 0;
+        }
+
         std::cout << "Parsing MPS file: " << mps_file_path << std::endl;
         
         // Parse the MPS file
-        std::unique_ptr<mps::LpData> lp_data = mps::parse_mps(mps_file_path);
+        std::unique_ptr<mps::LpData> lp_data = mps::parse_mps(mps_file_path, parse_options);
 
         if (!lp_data) {
              std::cerr << "Error: Failed to parse MPS file (returned null LpData)." << std::endl;
@@ -39,15 +138,12 @@ int main(int argc, char* argv[]) {
         std::cout << "Equality Constraints: " << lp_data->get_A_eq().rows() << std::endl;
         std::cout << "Inequality Constraints: " << lp_data->get_A_ineq().rows() << std::endl;
 
-        // Extract instance name from file path
-        std::string instance_name = fs::path(mps_file_path).stem().string();
-
         // Add debug output
         std::cout << "[DEBUG] n_vars before saving: " << lp_data->get_n_vars() << std::endl; 
 
         // Save the LpData to Parquet files
         std::cout << "\nSaving LP data to Parquet for instance: " << instance_name << std::endl;
-        auto [output_dir, save_time] = mps::save_lp_to_parquet(*lp_data, instance_name);
+        auto [output_dir, save_time] = mps::save_lp_to_parquet(*lp_data, instance_name, write_options);
         
         std::cout << "\nSuccessfully saved data to: " << output_dir << std::endl;
         std::cout << "Save time: " << save_time << " seconds" << std::endl;
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "mps_parser.h"
+#include "parquet_writer.h"
+#include "cli_args.h"
+#include "compressed_input.h"
+#include "conversion_cache.h"
+#include "log.h"
+#include "lp_snapshot.h"
+#include "lp_data.h"
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+
+struct BatchJob {
+    fs::path path;
+    std::uintmax_t size_bytes = 0;
+    std::uint64_t budget_bytes = 0;  // estimated text size, charged against --memory-budget-mb
+};
+
+// Compressed MPS text usually expands 5-10x; the budget charges a compressed file at this
+// multiple of its size, since its on-disk size says little about its memory use
+constexpr std::uint64_t kCompressedSizeFactor = 8;
+
+struct JobResult {
+    bool ok = false;
+    bool cached = false;
+    std::string output_dir;
+    std::string error;
+    int n_vars = 0;
+    double parse_time_seconds = 0.0;
+    double save_time_seconds = 0.0;
+    double wall_time_seconds = 0.0;
+};
+
+// Caps the total text size of the MPS files being converted at once.
+// Memory use of an instance scales with its text size, so this bounds peak RSS;
+// a file larger than the whole budget still runs, but only on its own.
+class InFlightBudget {
+public:
+    explicit InFlightBudget(std::uint64_t budget_bytes) : budget_bytes_(budget_bytes) {}
+
+    void acquire(std::uint64_t bytes) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_.wait(lock, [&] {
+            return in_flight_bytes_ == 0 || in_flight_bytes_ + bytes <= budget_bytes_;
+        });
+        in_flight_bytes_ += bytes;
+    }
+
+    void release(std::uint64_t bytes) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_flight_bytes_ -= bytes;
+        }
+        released_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    std::uint64_t budget_bytes_;
+    std::uint64_t in_flight_bytes_ = 0;
+};
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--jobs N] [--memory-budget-mb MB] [--list FILE] [--report FILE]"
+              << " [--reader stream|mmap] [--parse-threads N] [--presize] [--codec none|snappy|zstd|lz4]"
+              << " [--format parquet|feather] [--layout coo|csc|csr] [--int32-indices]"
+              << " [--row-group-size ROWS] [--concurrent-save] [--snapshot] [--no-cache] [--verbose] [<dir_or_mps_file>...]" << std::endl;
+}
+
+BatchJob make_job(const fs::path& path, std::uintmax_t size_bytes) {
+    const bool compressed = mps::detect_compression(path.string()) != mps::Compression::None;
+    return {path, size_bytes, compressed ? size_bytes * kCompressedSizeFactor : size_bytes};
+}
+
+// Adds an MPS file, or every .mps (.mps.gz, .mps.bz2, .mps.zst) file directly inside a directory
+void add_input(const fs::path& input, std::vector<BatchJob>& jobs) {
+    if (fs::is_directory(input)) {
+        for (const auto& entry : fs::directory_iterator(input)) {
+            if (entry.is_regular_file() && mps::is_mps_file_name(entry.path().string())) {
+                jobs.push_back(make_job(entry.path(), entry.file_size()));
+            }
+        }
+    } else if (fs::is_regular_file(input)) {
+        jobs.push_back(make_job(input, fs::file_size(input)));
+    } else {
+        throw std::runtime_error("Input not found: " + input.string());
+    }
+}
+
+// Drops inputs listed twice (e.g. a file also found through its directory) and rejects
+// distinct files that would share an output directory, such as x.mps next to x.mps.gz:
+// their workers would write into the same data/x_parquet at once
+void check_output_dirs(std::vector<BatchJob>& jobs) {
+    std::map<std::string, fs::path> owner_by_dir;
+    std::vector<BatchJob> unique_jobs;
+    std::string conflicts;
+    for (BatchJob& job : jobs) {
+        const std::string dir = mps::parquet_output_dir(mps::instance_name_from_path(job.path.string()));
+        const fs::path canonical = fs::weakly_canonical(job.path);
+        auto [it, inserted] = owner_by_dir.emplace(dir, canonical);
+        if (inserted) {
+            unique_jobs.push_back(std::move(job));
+        } else if (it->second != canonical) {
+            conflicts += "\n  " + it->second.string() + " and " + canonical.string() + " -> " + dir;
+        }
+    }
+    if (!conflicts.empty()) {
+        throw std::runtime_error("Inputs would be written to the same output directory:" + conflicts);
+    }
+    jobs = std::move(unique_jobs);
+}
+
+JobResult convert(const BatchJob& job, const mps::ParseOptions& parse_options,
+                  mps::OutputOptions write_options, bool use_cache) {
+    JobResult result;
+    const auto start_time = std::chrono::steady_clock::now();
+    try {
+        const std::string instance_name = mps::instance_name_from_path(job.path.string());
+        write_options.source_hash = mps::hash_file(job.path.string());
+        const fs::path cached_dir = mps::parquet_output_dir(instance_name);
+        const bool snapshot_ok = !write_options.snapshot || fs::exists(cached_dir / mps::kSnapshotFileName);
+        const bool cached = mps::is_cached_conversion(cached_dir.string(), write_options.source_hash,
+                                                      mps::conversion_key(write_options));
+        if (use_cache && snapshot_ok && cached) {
+            result.ok = true;
+            result.cached = true;
+            result.output_dir = mps::parquet_output_dir(instance_name);
+            result.wall_time_seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            return result;
+        }
+
+        std::unique_ptr<mps::LpData> lp_data = mps::parse_mps(job.path.string(), parse_options);
+        auto [output_dir, save_time] = mps::save_lp_to_parquet(*lp_data, instance_name, write_options);
+        result.ok = true;
+        result.output_dir = output_dir;
+        result.n_vars = lp_data->get_n_vars();
+        result.parse_time_seconds = lp_data->get_parse_time_seconds();
+        result.save_time_seconds = save_time;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    } catch (...) {
+        result.error = "unknown error";
+    }
+    result.wall_time_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    mps::ParseOptions parse_options;
+    mps::OutputOptions write_options;
+    unsigned int n_jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::uint64_t memory_budget_mb = 0;  // 0 = no budget beyond the job count
+    fs::path report_path = fs::path("data") / "batch_report.json";
+    std::vector<BatchJob> jobs;
+    bool use_cache = true;
+    mps::LogLevel log_level = mps::LogLevel::Warning;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            const bool has_value = i + 1 < argc;
+            if (arg == "--jobs" && has_value) {
+                n_jobs = mps::parse_int_option(arg, argv[++i], 1u);
+            } else if (arg == "--memory-budget-mb" && has_value) {
+                // Capped so the budget in bytes cannot overflow
+                memory_budget_mb = mps::parse_int_option<std::uint64_t>(arg, argv[++i], 0, UINT64_MAX >> 20);
+            } else if (arg == "--report" && has_value) {
+                report_path = argv[++i];
+            } else if (arg == "--reader" && has_value) {
+                std::string backend = argv[++i];
+                if (backend == "stream") {
+                    parse_options.backend = mps::ReaderBackend::Stream;
+                } else if (backend == "mmap") {
+                    parse_options.backend = mps::ReaderBackend::Mmap;
+                } else {
+                    throw std::invalid_argument("Unknown reader backend: " + backend);
+                }
+            } else if (arg == "--parse-threads" && has_value) {
+                parse_options.num_threads = mps::parse_int_option(arg, argv[++i], 0);
+            } else if (arg == "--presize") {
+                parse_options.presize = true;
+            } else if (arg == "--codec" && has_value) {
+                write_options.codec = mps::parse_compression_codec(argv[++i]);
+            } else if (arg == "--format" && has_value) {
+                write_options.format = mps::parse_output_format(argv[++i]);
+            } else if (arg == "--layout" && has_value) {
+                write_options.matrix_layout = mps::parse_matrix_layout(argv[++i]);
+            } else if (arg == "--int32-indices") {
+                write_options.narrow_indices = true;
+            } else if (arg == "--row-group-size" && has_value) {
+                write_options.row_group_size = mps::parse_int_option<int64_t>(arg, argv[++i], 1);
+            } else if (arg == "--concurrent-save") {
+                write_options.concurrent_files = true;
+            } else if (arg == "--snapshot") {
+                write_options.snapshot = true;
+            } else if (arg == "--no-cache") {
+                use_cache = false;
+            } else if (arg == "--verbose") {
+                log_level = mps::LogLevel::Debug;
+            } else if (arg == "--list" && has_value) {
+                std::ifstream list(argv[++i]);
+                if (!list.is_open()) {
+                    throw std::runtime_error(std::string("Failed to open file list: ") + argv[i]);
+                }
+                std::string line;
+                while (std::getline(list, line)) {
+                    if (!line.empty()) add_input(line, jobs);
+                }
+            } else if (arg.rfind("--", 0) != 0) {
+                add_input(arg, jobs);
+            } else {
+                throw std::invalid_argument("Unknown option or missing value: " + arg);
+            }
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (jobs.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    try {
+        check_output_dirs(jobs);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // Workers only reach the console for library warnings, or every phase timing with --verbose;
+    // each message is written whole, so lines from different workers never interleave
+    mps::set_log_sink(mps::stream_log_sink(std::cerr), log_level);
+
+    // Largest files first, so the long conversions do not end up running last on their own
+    std::stable_sort(jobs.begin(), jobs.end(),
+                     [](const BatchJob& a, const BatchJob& b) { return a.budget_bytes > b.budget_bytes; });
+
+    // Keep workers x COLUMNS threads within the cores: --parse-threads 0 shares them out,
+    // an explicit count lowers the number of workers
+    n_jobs = std::min<size_t>(n_jobs, jobs.size());
+    const unsigned int n_cores = std::max(1u, std::thread::hardware_concurrency());
+    if (parse_options.num_threads == 0) {
+        parse_options.num_threads = static_cast<int>(std::max(1u, n_cores / n_jobs));
+    } else if (static_cast<uint64_t>(n_jobs) * parse_options.num_threads > n_cores) {
+        n_jobs = std::max(1u, n_cores / static_cast<unsigned int>(parse_options.num_threads));
+    }
+    std::cout << "Converting " << jobs.size() << " MPS file(s) with " << n_jobs << " worker(s) of "
+              << parse_options.num_threads << " parse thread(s)" << std::endl;
+
+    const auto start_time = std::chrono::steady_clock::now();
+    std::vector<JobResult> results(jobs.size());
+    std::atomic<size_t> next_job{0};
+    InFlightBudget budget(memory_budget_mb > 0 ? memory_budget_mb << 20 : UINT64_MAX);
+
+    std::vector<std::thread> workers;
+    for (unsigned int w = 0; w < n_jobs; ++w) {
+        workers.emplace_back([&] {
+            for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+                budget.acquire(jobs[i].budget_bytes);
+                results[i] = convert(jobs[i], parse_options, write_options, use_cache);
+                budget.release(jobs[i].budget_bytes);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double total_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    // Summary report
+    json files = json::array();
+    size_t n_failed = 0;
+    size_t n_cached = 0;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const JobResult& result = results[i];
+        json entry = {
+            {"path", jobs[i].path.string()},
+            {"size_bytes", jobs[i].size_bytes},
+            {"ok", result.ok},
+            {"cached", result.cached},
+            {"wall_time_seconds", result.wall_time_seconds}
+        };
+        if (result.cached) {
+            entry["output_dir"] = result.output_dir;
+            ++n_cached;
+        } else if (result.ok) {
+            entry["output_dir"] = result.output_dir;
+            entry["n_vars"] = result.n_vars;
+            entry["parse_time_seconds"] = result.parse_time_seconds;
+            entry["save_parquet_time_seconds"] = result.save_time_seconds;
+        } else {
+            entry["error"] = result.error;
+            ++n_failed;
+            std::cerr << "Failed: " << jobs[i].path << ": " << result.error << std::endl;
+        }
+        files.push_back(entry);
+    }
+
+    json report = {
+        {"n_files", jobs.size()},
+        {"n_failed", n_failed},
+        {"n_cached", n_cached},
+        {"n_workers", n_jobs},
+        {"memory_budget_mb", memory_budget_mb},
+        {"total_time_seconds", total_time},
+        {"files", files}
+    };
+
+    if (report_path.has_parent_path()) {
+        fs::create_directories(report_path.parent_path());
+    }
+    std::ofstream report_file(report_path);
+    report_file << report.dump(4);
+    report_file.close();
+
+    std::cout << "Converted " << jobs.size() - n_failed << "/" << jobs.size() << " file(s) in "
+              << total_time << " seconds (" << n_cached << " up to date); report written to " << report_path << std::endl;
+
+    return n_failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+#include "parse_stats.h"
+#include <nlohmann/json.hpp>
+#include <sys/resource.h>
+
+namespace mps {
+
+size_t peak_rss_bytes() {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);  // already bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;  // KiB on Linux
+#endif
+}
+
+void to_json(nlohmann::json& j, const MpsSection& section) {
+    j = {
+        {"name", section.name},
+        {"byte_offset", section.byte_offset},
+        {"lines", section.line_count},
+        {"bytes", section.bytes},
+        {"seconds", section.seconds}
+    };
+}
+
+void to_json(nlohmann::json& j, const ParseStats& stats) {
+    j = {
+        {"problem_name", stats.scan.problem_name},
+        {"lines", stats.scan.line_count},
+        {"bytes", stats.scan.byte_count},
+        {"sections", stats.scan.sections},
+        {"read_seconds", stats.read_seconds},
+        {"bounds_seconds", stats.bounds_seconds},
+        {"build_matrices_seconds", stats.build_matrices_seconds},
+        {"assembly_seconds", stats.assembly_seconds},
+        {"total_seconds", stats.total_seconds},
+        {"parser_allocations", stats.parser_memory.allocations},
+        {"parser_allocated_bytes", stats.parser_memory.bytes},
+        {"process_peak_rss_bytes", stats.process_peak_rss_bytes}
+    };
+}
+
+void to_json(nlohmann::json& j, const SaveFileStats& stats) {
+    j = {
+        {"seconds", stats.seconds},
+        {"encode_seconds", stats.encode_seconds},
+        {"write_seconds", stats.write_seconds},
+        {"bytes", stats.bytes}
+    };
+}
+
+} // namespace mps
@@ -0,0 +1,44 @@
+#ifndef PARSE_STATS_H
+#define PARSE_STATS_H
+
+#include "counting_resource.h"
+#include "mps_reader.h"
+#include <nlohmann/json_fwd.hpp>
+#include <cstddef>
+#include <string>
+
+namespace mps {
+
+// Where the time and memory of one parse_mps call went
+struct ParseStats {
+    MpsScan scan;                   // per-section lines, bytes and wall time
+    double read_seconds = 0.0;      // all sections, up to ENDATA
+    double bounds_seconds = 0.0;    // default bounds and the lb/ub vectors
+    double build_matrices_seconds = 0.0;
+    double assembly_seconds = 0.0;  // part of build_matrices spent in setFromTriplets (Triplets)
+                                    // or in the count and fill passes (Direct)
+    double total_seconds = 0.0;
+    AllocationStats parser_memory;  // allocations that reached the parser's backing resource
+    size_t process_peak_rss_bytes = 0;  // high-water mark of the whole process when the parse ended:
+                                        // includes earlier work and, in batch mode, every other job
+};
+
+// Where the time of one file written by save_lp_to_parquet went
+struct SaveFileStats {
+    double seconds = 0.0;         // the whole file: Arrow table construction, encoding and writing
+    double encode_seconds = 0.0;  // Parquet encoding and compression
+    double write_seconds = 0.0;   // inside the output stream's Write calls
+    size_t bytes = 0;             // file size
+};
+
+// Peak resident set size of this process so far, in bytes (0 where unsupported)
+size_t peak_rss_bytes();
+
+// Serialization into metadata.json
+void to_json(nlohmann::json& j, const MpsSection& section);
+void to_json(nlohmann::json& j, const ParseStats& stats);
+void to_json(nlohmann::json& j, const SaveFileStats& stats);
+
+} // namespace mps
+
+#endif // PARSE_STATS_H
@@ -0,0 +1,92 @@
+#include "symbol_table.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace mps {
+
+namespace {
+
+constexpr size_t kInitialSlots = 64;
+constexpr size_t kArenaBlockSize = 1 << 16;
+
+} // namespace
+
+SymbolTable::SymbolTable(std::pmr::memory_resource* resource)
+    : resource_(resource), names_(resource), hashes_(resource), slots_(kInitialSlots, -1, resource),
+      blocks_(resource) {}
+
+SymbolTable::~SymbolTable() {
+    for (const auto& block : blocks_) {
+        resource_->deallocate(block.first, block.second, 1);
+    }
+}
+
+size_t SymbolTable::slot_for(std::string_view name, size_t hash) const {
+    // Linear probing; the table is a power of two and never more than half full
+    const size_t mask = slots_.size() - 1;
+    size_t slot = hash & mask;
+    while (slots_[slot] != -1) {
+        const int id = slots_[slot];
+        if (hashes_[id] == hash && names_[id] == name) break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+int SymbolTable::find(std::string_view name) const {
+    const size_t hash = std::hash<std::string_view>{}(name);
+    return slots_[slot_for(name, hash)];
+}
+
+int SymbolTable::intern(std::string_view name) {
+    const size_t hash = std::hash<std::string_view>{}(name);
+    size_t slot = slot_for(name, hash);
+    if (slots_[slot] != -1) {
+        return slots_[slot];
+    }
+
+    const int id = size();
+    names_.emplace_back(store(name), name.size());
+    hashes_.push_back(hash);
+    slots_[slot] = id;
+
+    if (names_.size() * 2 > slots_.size()) {
+        rehash(slots_.size() * 2);
+    }
+    return id;
+}
+
+void SymbolTable::reserve(size_t count) {
+    names_.reserve(count);
+    hashes_.reserve(count);
+    size_t capacity = slots_.size();
+    while (count * 2 > capacity) capacity *= 2;
+    if (capacity != slots_.size()) {
+        rehash(capacity);
+    }
+}
+
+void SymbolTable::rehash(size_t capacity) {
+    slots_.assign(capacity, -1);
+    const size_t mask = capacity - 1;
+    for (int id = 0; id < size(); ++id) {
+        size_t slot = hashes_[id] & mask;
+        while (slots_[slot] != -1) slot = (slot + 1) & mask;
+        slots_[slot] = id;
+    }
+}
+
+const char* SymbolTable::store(std::string_view name) {
+    if (blocks_.empty() || block_used_ + name.size() > block_capacity_) {
+        block_capacity_ = std::max(kArenaBlockSize, name.size());
+        blocks_.emplace_back(static_cast<char*>(resource_->allocate(block_capacity_, 1)), block_capacity_);
+        block_used_ = 0;
+    }
+    char* dest = blocks_.back().first + block_used_;
+    std::memcpy(dest, name.data(), name.size());
+    block_used_ += name.size();
+    return dest;
+}
+
+} // namespace mps
@@ -0,0 +1,62 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace mps {
+
+/**
+ * Interns names to dense integer ids (0, 1, 2, ... in first-seen order).
+ * Name bytes are copied once into an arena of large blocks, so views returned
+ * by name() stay valid for the lifetime of the table. The blocks and the index
+ * arrays come from the given memory resource.
+ */
+class SymbolTable {
+public:
+    explicit SymbolTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    ~SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * Returns the id of a name, assigning the next id if the name is new.
+     * @param name The name to intern
+     * @return The dense id of the name
+     */
+    int intern(std::string_view name);
+
+    /**
+     * Looks up a name without inserting it.
+     * @param name The name to look up
+     * @return The id of the name, or -1 if it was never interned
+     */
+    int find(std::string_view name) const;
+
+    // Pre-allocates room for the given number of names
+    void reserve(size_t count);
+
+    std::string_view name(int id) const { return names_[id]; }
+    int size() const { return static_cast<int>(names_.size()); }
+
+private:
+    size_t slot_for(std::string_view name, size_t hash) const;
+    void rehash(size_t capacity);
+    const char* store(std::string_view name);
+
+    std::pmr::memory_resource* resource_;
+    std::pmr::vector<std::string_view> names_;  // id -> name (points into the arena)
+    std::pmr::vector<size_t> hashes_;           // id -> hash, reused when rehashing
+    std::pmr::vector<int> slots_;               // open-addressing table of ids, -1 = empty
+    std::pmr::vector<std::pair<char*, size_t>> blocks_;  // arena blocks holding the name bytes
+    size_t block_used_ = 0;
+    size_t block_capacity_ = 0;
+};
+
+} // namespace mps
+
+#endif // SYMBOL_TABLE_H
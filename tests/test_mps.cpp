@@ -1,10 +1,84 @@
 #include <gtest/gtest.h>
+#include "cli_args.h"
+#include "compressed_input.h"
+#include "conversion_cache.h"
+#include "log.h"
+#include "lp_snapshot.h"
+#include "mps_generator.h"
 #include "mps_parser.h"
 #include "mps_reader.h"
+#include "mps_tokenizer.h"
+#include "number_parser.h"
+#include "parse_stats.h"
+#include "symbol_table.h"
+#include <array>
 #include <memory>
 #include <stdexcept>
 #include <set>
 #include <cstdlib>
+#include <cstdio>
+#include <limits>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory_resource>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#ifdef MPS_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef MPS_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef MPS_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Asserts that two parsed models are identical, entry by entry
+static void expect_lp_data_equal(const mps::LpData& a, const mps::LpData& b) {
+    ASSERT_EQ(a.get_n_vars(), b.get_n_vars());
+    ASSERT_EQ(a.get_col_names(), b.get_col_names());
+    ASSERT_TRUE(a.get_c() == b.get_c());
+    ASSERT_TRUE(a.get_lb() == b.get_lb());
+    ASSERT_TRUE(a.get_ub() == b.get_ub());
+    ASSERT_TRUE(a.get_b_eq() == b.get_b_eq());
+    ASSERT_TRUE(a.get_b_ineq() == b.get_b_ineq());
+    ASSERT_EQ(a.get_obj_offset(), b.get_obj_offset());
+
+    const std::pair<const Eigen::SparseMatrix<double>*, const Eigen::SparseMatrix<double>*> matrices[] = {
+        {&a.get_A_eq(), &b.get_A_eq()}, {&a.get_A_ineq(), &b.get_A_ineq()}};
+    for (const auto& [ma, mb] : matrices) {
+        ASSERT_EQ(ma->rows(), mb->rows());
+        ASSERT_EQ(ma->cols(), mb->cols());
+        ASSERT_EQ(ma->nonZeros(), mb->nonZeros());
+        ASSERT_EQ((*ma - *mb).norm(), 0.0);
+    }
+}
+
+// Small model exercising G rows, repeated coefficients and a column listed twice
+static std::string write_edge_case_mps() {
+    const auto path = std::filesystem::temp_directory_path() / "mps_parser_edge_case.mps";
+    std::ofstream out(path);
+    out << "NAME          EDGE\n"
+           "ROWS\n"
+           " N  cost\n G  g1\n L  l1\n E  e1\n G  g2\n"
+           "COLUMNS\n"
+           "    MARKER                 'MARKER'                 'INTORG'\n"
+           "    x1        cost      1.5        g1        2\n"
+           "    x1        e1        4          e1        5\n"
+           "    MARKER                 'MARKER'                 'INTEND'\n"
+           "    x2        cost      -1         l1        7.25\n"
+           "    x3        e1        -0.5       g1        1\n"
+           "    x1        l1        9          g2        3\n"
+           "RHS\n"
+           "    rhs       g1        10         e1        3\n"
+           "BOUNDS\n"
+           " UP bnd       x1        4\n"
+           " MI bnd       x2\n"
+           "ENDATA\n";
+    return path.string();
+}
 
 class MPSParserTest : public ::testing::Test {
 protected:
@@ -123,4 +197,831 @@ TEST_F(MPSParserTest, CheckParseTime) {
         << "Parse time is unexpectedly close to zero."; 
     ASSERT_LT(parse_time, 10.0)
         << "Parse time seems excessively long (\"> 10s\")";
-} 
\ No newline at end of file
+}
+
+TEST_F(MPSParserTest, ReaderBackendsProduceSameLpData) {
+    mps::ParseOptions options;
+    options.backend = mps::ReaderBackend::Stream;
+    auto stream_data = mps::parse_mps(valid_filename, options);
+    options.backend = mps::ReaderBackend::Mmap;
+    auto mmap_data = mps::parse_mps(valid_filename, options);
+
+    ASSERT_NE(stream_data, nullptr);
+    ASSERT_NE(mmap_data, nullptr);
+    expect_lp_data_equal(*stream_data, *mmap_data);
+}
+
+TEST_F(MPSParserTest, MmapBackendInvalidFile) {
+    mps::ParseOptions options;
+    options.backend = mps::ReaderBackend::Mmap;
+    ASSERT_THROW(mps::parse_mps(invalid_filename, options), std::runtime_error)
+        << "Should throw when file doesn't exist";
+}
+
+TEST_F(MPSParserTest, ScanIsCollectedDuringParse) {
+    for (auto backend : {mps::ReaderBackend::Stream, mps::ReaderBackend::Mmap}) {
+        for (int num_threads : {1, 4}) {
+            mps::ParseOptions options;
+            options.backend = backend;
+            options.num_threads = num_threads;
+            mps::MpsScan scan;
+            auto data = mps::parse_mps(valid_filename, options, scan);
+            ASSERT_NE(data, nullptr);
+
+            ASSERT_EQ(scan.problem_name, mps::read_problem_name(valid_filename));
+            ASSERT_EQ(scan.line_count, static_cast<size_t>(mps::count_lines(valid_filename)));
+            ASSERT_FALSE(scan.header_only);
+            ASSERT_EQ(scan.sections.size(), 5u);
+
+            const mps::MpsSection* rows = scan.find_section("ROWS");
+            const mps::MpsSection* columns = scan.find_section("COLUMNS");
+            const mps::MpsSection* bounds = scan.find_section("BOUNDS");
+            ASSERT_NE(rows, nullptr);
+            ASSERT_NE(columns, nullptr);
+            ASSERT_NE(bounds, nullptr);
+            ASSERT_EQ(scan.find_section("RANGES"), nullptr);
+            ASSERT_EQ(scan.sections.front().name, "NAME");
+            ASSERT_EQ(rows->byte_offset, 21u);
+            ASSERT_EQ(rows->line_count, 234u);
+            ASSERT_EQ(columns->byte_offset, 3068u);
+            ASSERT_EQ(columns->line_count, 4394u);
+            ASSERT_EQ(bounds->byte_offset, 215240u);
+            ASSERT_EQ(bounds->line_count, 1647u);
+        }
+    }
+}
+
+TEST_F(MPSParserTest, ParseStatsCoverEveryPhase) {
+    for (auto assembly : {mps::MatrixAssembly::Triplets, mps::MatrixAssembly::Direct}) {
+        mps::ParseOptions options;
+        options.assembly = assembly;
+        auto data = mps::parse_mps(valid_filename, options);
+        ASSERT_NE(data, nullptr);
+        const mps::ParseStats& stats = data->get_parse_stats();
+
+        // Sections tile the file up to ENDATA, and their times add up to the read phase
+        ASSERT_EQ(stats.scan.byte_count, std::filesystem::file_size(valid_filename) - 7);  // "ENDATA\n"
+        size_t bytes = 0, lines = 0;
+        double seconds = 0.0;
+        for (const auto& section : stats.scan.sections) {
+            bytes += section.bytes;
+            lines += section.line_count + 1;
+            seconds += section.seconds;
+        }
+        ASSERT_EQ(bytes, stats.scan.byte_count);
+        ASSERT_EQ(lines + 1, stats.scan.line_count);
+        for (size_t i = 0; i + 1 < stats.scan.sections.size(); ++i) {
+            const auto& section = stats.scan.sections[i];
+            ASSERT_EQ(section.byte_offset + section.bytes, stats.scan.sections[i + 1].byte_offset);
+        }
+        ASSERT_LE(seconds, stats.read_seconds);
+
+        ASSERT_GT(stats.read_seconds, 0.0);
+        ASSERT_GT(stats.build_matrices_seconds, 0.0);
+        ASSERT_GT(stats.assembly_seconds, 0.0);
+        ASSERT_LE(stats.assembly_seconds, stats.build_matrices_seconds);
+        ASSERT_LE(stats.read_seconds + stats.bounds_seconds + stats.build_matrices_seconds, stats.total_seconds);
+        ASSERT_DOUBLE_EQ(stats.total_seconds, data->get_parse_time_seconds());
+        ASSERT_GT(stats.parser_memory.allocations, 0u);
+        ASSERT_GT(stats.process_peak_rss_bytes, 0u);
+
+        const nlohmann::json j = stats;
+        ASSERT_EQ(j.at("problem_name"), "50v-10");
+        ASSERT_EQ(j.at("sections").size(), 5u);
+        ASSERT_EQ(j.at("sections")[2].at("name"), "COLUMNS");
+        ASSERT_EQ(j.at("sections")[2].at("lines"), 4394u);
+        ASSERT_EQ(j.at("process_peak_rss_bytes"), stats.process_peak_rss_bytes);
+    }
+}
+
+TEST_F(MPSParserTest, LoggingIsSilentUntilASinkIsSet) {
+    // Nothing reaches the console by default
+    std::ostringstream console;
+    std::streambuf* cout_buffer = std::cout.rdbuf(console.rdbuf());
+    std::streambuf* cerr_buffer = std::cerr.rdbuf(console.rdbuf());
+    mps::parse_mps(valid_filename);
+    std::cout.rdbuf(cout_buffer);
+    std::cerr.rdbuf(cerr_buffer);
+    ASSERT_EQ(console.str(), "");
+    ASSERT_FALSE(mps::log_enabled(mps::LogLevel::Error));
+
+    std::vector<std::pair<mps::LogLevel, std::string>> messages;
+    auto sink = [&](mps::LogLevel level, std::string_view message) { messages.emplace_back(level, message); };
+    mps::set_log_sink(sink, mps::LogLevel::Info);
+    mps::parse_mps(valid_filename);
+    ASSERT_TRUE(messages.empty());  // phase timings are debug messages
+
+    mps::set_log_sink(sink, mps::LogLevel::Debug);
+    mps::parse_mps(valid_filename);
+    ASSERT_FALSE(messages.empty());
+    for (const auto& [level, message] : messages) {
+        ASSERT_EQ(level, mps::LogLevel::Debug);
+    }
+    ASSERT_EQ(messages.back().second.rfind("Total parsing time: ", 0), 0u);
+
+    // A failed parse is reported by its exception only
+    messages.clear();
+    ASSERT_THROW(mps::parse_mps(invalid_filename), std::runtime_error);
+    mps::set_log_sink(nullptr);
+    for (const auto& [level, message] : messages) {
+        ASSERT_NE(level, mps::LogLevel::Error);
+    }
+
+    std::ostringstream out;
+    mps::stream_log_sink(out)(mps::LogLevel::Warning, "RANGES section is not currently handled");
+    ASSERT_EQ(out.str(), "Warning: RANGES section is not currently handled\n");
+}
+
+TEST_F(MPSParserTest, HeaderScanStopsAtColumns) {
+    const mps::MpsScan scan = mps::scan_mps_header(valid_filename);
+    ASSERT_TRUE(scan.header_only);
+    ASSERT_EQ(scan.problem_name, "50v-10");
+    ASSERT_EQ(scan.line_count, 237u);
+    ASSERT_EQ(scan.sections.size(), 3u);
+    ASSERT_EQ(scan.sections[1].name, "ROWS");
+    ASSERT_EQ(scan.sections[1].line_count, 234u);
+    ASSERT_EQ(scan.sections[2].name, "COLUMNS");
+    ASSERT_EQ(scan.sections[2].byte_offset, 3068u);
+    ASSERT_THROW(mps::scan_mps_header(invalid_filename), std::runtime_error);
+}
+
+TEST(MPSTokenizerTest, SplitsLinesAndFields) {
+    mps::LineReader lines("NAME  test\r\n    x1  c1  1.5\n\nENDATA");
+    std::string_view line, token;
+
+    ASSERT_TRUE(lines.next(line));
+    ASSERT_EQ(mps::trim_view(line), "NAME  test");
+    ASSERT_TRUE(lines.next(line));
+
+    mps::TokenCursor tokens(line);
+    std::vector<std::string_view> fields;
+    while (tokens.next(token)) fields.push_back(token);
+    ASSERT_EQ(fields, (std::vector<std::string_view>{"x1", "c1", "1.5"}));
+
+    ASSERT_TRUE(lines.next(line));
+    ASSERT_TRUE(line.empty());
+    ASSERT_TRUE(lines.next(line));
+    ASSERT_EQ(line, "ENDATA");
+    ASSERT_FALSE(lines.next(line));
+}
+
+TEST(NumberParserTest, ParsesMpsNumbers) {
+    ASSERT_EQ(mps::parse_double("-12"), -12.0);
+    ASSERT_EQ(mps::parse_double("+3.5"), 3.5);
+    ASSERT_EQ(mps::parse_double("61.0499996691942"), 61.0499996691942);
+    ASSERT_EQ(mps::parse_double(".5"), 0.5);
+    ASSERT_EQ(mps::parse_double("1e30"), 1e30);
+    ASSERT_EQ(mps::parse_double("-1.0E+30"), -1e30);
+    ASSERT_EQ(mps::parse_double("Infinity"), std::numeric_limits<double>::infinity());
+    ASSERT_EQ(mps::parse_double("-inf"), -std::numeric_limits<double>::infinity());
+    ASSERT_EQ(mps::parse_double("+INF"), std::numeric_limits<double>::infinity());
+    ASSERT_EQ(mps::parse_double("1e400"), std::numeric_limits<double>::infinity());
+    ASSERT_EQ(mps::parse_double("-1e-400"), 0.0);
+
+    ASSERT_THROW(mps::parse_double("12abc"), std::runtime_error);
+    ASSERT_THROW(mps::parse_double(""), std::runtime_error);
+    ASSERT_THROW(mps::parse_double("+"), std::runtime_error);
+    ASSERT_THROW(mps::parse_double("+-1"), std::runtime_error);
+    ASSERT_THROW(mps::parse_double("'INTORG'"), std::runtime_error);
+}
+
+TEST(NumberParserTest, RoundTripsShortestRepresentation) {
+    const double samples[] = {0.1, 1.0 / 3.0, 61.0499996691942, 5e-324, 1.7976931348623157e308,
+                              -2.2250738585072014e-308, 123456789.123456789};
+    for (double expected : samples) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", expected);
+        ASSERT_EQ(mps::parse_double(buffer), expected) << buffer;
+    }
+}
+
+TEST(SymbolTableTest, InternsDenseIdsInFirstSeenOrder) {
+    mps::SymbolTable table;
+    ASSERT_EQ(table.intern("c1"), 0);
+    ASSERT_EQ(table.intern("x367"), 1);
+    ASSERT_EQ(table.intern("c1"), 0);
+    ASSERT_EQ(table.find("x367"), 1);
+    ASSERT_EQ(table.find("missing"), -1);
+
+    // Growing past the initial table keeps every id and name stable
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(table.intern("name" + std::to_string(i)), i + 2);
+    }
+    ASSERT_EQ(table.size(), 1002);
+    ASSERT_EQ(table.name(0), "c1");
+    ASSERT_EQ(table.name(501), "name499");
+    ASSERT_EQ(table.find("name999"), 1001);
+}
+
+TEST_F(MPSParserTest, MatrixAssemblyModesProduceSameLpData) {
+    mps::ParseOptions options;
+    options.assembly = mps::MatrixAssembly::Triplets;
+    auto triplet_data = mps::parse_mps(valid_filename, options);
+    options.assembly = mps::MatrixAssembly::Direct;
+    auto direct_data = mps::parse_mps(valid_filename, options);
+
+    expect_lp_data_equal(*triplet_data, *direct_data);
+    ASSERT_TRUE(direct_data->get_A_eq().isCompressed());
+    ASSERT_TRUE(direct_data->get_A_ineq().isCompressed());
+}
+
+TEST_F(MPSParserTest, ParallelColumnsMatchSerial) {
+    mps::ParseOptions options;
+    auto serial_data = mps::parse_mps(valid_filename, options);
+    options.num_threads = 4;
+    auto parallel_data = mps::parse_mps(valid_filename, options);
+
+    expect_lp_data_equal(*serial_data, *parallel_data);
+}
+
+TEST_F(MPSParserTest, PresizedParseMatchesDefault) {
+    mps::ParseOptions options;
+    options.presize = true;
+    auto presized_data = mps::parse_mps(valid_filename, options);
+    expect_lp_data_equal(*lp_data, *presized_data);
+    options.num_threads = 4;
+    presized_data = mps::parse_mps(valid_filename, options);
+    expect_lp_data_equal(*lp_data, *presized_data);
+}
+
+TEST(MPSParserEdgeCaseTest, PrescanCountsUpperBounds) {
+    const std::string path = write_edge_case_mps();
+    std::ifstream in(path);
+    const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    const mps::MpsSizeHints sizes = mps::prescan_mps_sizes(text);
+    ASSERT_EQ(sizes.rows, 5u);
+    ASSERT_EQ(sizes.columns, 4u);   // x1 is counted again where it reappears; markers are skipped
+    ASSERT_EQ(sizes.nonzeros, 10u); // objective and repeated entries included
+
+    mps::ParseOptions options;
+    options.presize = true;
+    auto presized_data = mps::parse_mps(path, options);
+    auto data = mps::parse_mps(path);
+    expect_lp_data_equal(*data, *presized_data);
+    std::remove(path.c_str());
+}
+
+TEST(MPSParserEdgeCaseTest, DirectAssemblyHandlesRepeatsAndReorderedColumns) {
+    const std::string path = write_edge_case_mps();
+    mps::ParseOptions options;
+    options.assembly = mps::MatrixAssembly::Direct;
+    auto direct_data = mps::parse_mps(path, options);
+    options.assembly = mps::MatrixAssembly::Triplets;
+    auto triplet_data = mps::parse_mps(path, options);
+    options.num_threads = 2;
+    auto parallel_data = mps::parse_mps(path, options);
+    std::filesystem::remove(path);
+
+    expect_lp_data_equal(*direct_data, *triplet_data);
+    expect_lp_data_equal(*direct_data, *parallel_data);
+    ASSERT_EQ(direct_data->get_col_names(), (std::vector<std::string>{"x1", "x2", "x3"}));
+
+    // e1 keeps the last of its repeated x1 coefficients
+    const auto& A_eq = direct_data->get_A_eq();
+    ASSERT_EQ(A_eq.rows(), 1);
+    ASSERT_EQ(A_eq.coeff(0, 0), 5.0);
+    ASSERT_EQ(A_eq.coeff(0, 2), -0.5);
+
+    // Inequalities: l1 first, then g1 and g2 negated; x1's late entries are merged in
+    const auto& A_ineq = direct_data->get_A_ineq();
+    ASSERT_EQ(A_ineq.rows(), 3);
+    ASSERT_EQ(A_ineq.coeff(0, 0), 9.0);
+    ASSERT_EQ(A_ineq.coeff(0, 1), 7.25);
+    ASSERT_EQ(A_ineq.coeff(1, 0), -2.0);
+    ASSERT_EQ(A_ineq.coeff(1, 2), -1.0);
+    ASSERT_EQ(A_ineq.coeff(2, 0), -3.0);
+    ASSERT_EQ(direct_data->get_b_ineq()(1), -10.0);
+}
+
+TEST(MPSParserEdgeCaseTest, ColumnNamedNameIsData) {
+    const std::string path = (std::filesystem::temp_directory_path() / "name_column_test.mps").string();
+    {
+        std::ofstream out(path);
+        out << "NAME          NAMECOL\n"
+               "ROWS\n"
+               " N  cost\n E  e1\n L  l1\n"
+               "COLUMNS\n"
+               "    x1        cost      1          e1        2\n"
+               "    NAME      cost      3          l1        4\n"
+               "NAME          e1        5\n"
+               "RHS\n"
+               "    NAME      e1        6          l1        7\n"
+               "ENDATA\n";
+    }
+
+    auto data = mps::parse_mps(path);
+    ASSERT_EQ(data->get_col_names(), (std::vector<std::string>{"x1", "NAME"}));
+    ASSERT_EQ(data->get_c()(1), 3.0);
+    ASSERT_EQ(data->get_A_eq().coeff(0, 1), 5.0);
+    ASSERT_EQ(data->get_A_ineq().coeff(0, 1), 4.0);
+    ASSERT_EQ(data->get_b_eq()(0), 6.0);
+    ASSERT_EQ(data->get_b_ineq()(0), 7.0);
+
+    mps::ParseOptions options;
+    options.backend = mps::ReaderBackend::Stream;
+    expect_lp_data_equal(*data, *mps::parse_mps(path, options));
+    options.backend = mps::ReaderBackend::Mmap;
+    options.num_threads = 2;
+    options.presize = true;
+    mps::MpsScan scan;
+    expect_lp_data_equal(*data, *mps::parse_mps(path, options, scan));
+    ASSERT_EQ(scan.problem_name, "NAMECOL");
+    ASSERT_EQ(scan.sections.size(), 4u);  // NAME, ROWS, COLUMNS, RHS
+    ASSERT_EQ(scan.find_section("COLUMNS")->line_count, 3u);
+    std::filesystem::remove(path);
+}
+
+// Records every coefficient handed to a sink, with the row's name
+class RecordingSink : public mps::CoefficientSink {
+public:
+    struct Call {
+        int col;
+        std::vector<std::pair<std::string, double>> entries;
+    };
+
+    void add_column(const mps::ParserState& state, int col, const int* rows, const double* values,
+                    size_t count) override {
+        Call call{col, {}};
+        for (size_t k = 0; k < count; ++k) {
+            call.entries.emplace_back(std::string(state.get_row_name(rows[k])), values[k]);
+        }
+        calls.push_back(std::move(call));
+    }
+
+    std::vector<Call> calls;
+};
+
+TEST(MPSParserEdgeCaseTest, CoefficientSinkReceivesColumnsInsteadOfMatrices) {
+    const std::string path = write_edge_case_mps();
+    auto expected = mps::parse_mps(path);
+    RecordingSink sink;
+    mps::ParseOptions options;
+    options.coefficient_sink = &sink;
+    auto data = mps::parse_mps(path, options);
+    std::filesystem::remove(path);
+
+    using Entries = std::vector<std::pair<std::string, double>>;
+    ASSERT_EQ(sink.calls.size(), 5u);
+    ASSERT_EQ(sink.calls[0].col, 0);
+    ASSERT_EQ(sink.calls[0].entries, (Entries{{"g1", 2.0}, {"e1", 5.0}}));
+    ASSERT_EQ(sink.calls[1].col, 1);
+    ASSERT_EQ(sink.calls[1].entries, (Entries{{"l1", 7.25}}));
+    // x1 listed again after x3: one call per entry, while x3 is still the open column
+    ASSERT_EQ(sink.calls[2].col, 0);
+    ASSERT_EQ(sink.calls[2].entries, (Entries{{"l1", 9.0}}));
+    ASSERT_EQ(sink.calls[3].col, 0);
+    ASSERT_EQ(sink.calls[3].entries, (Entries{{"g2", 3.0}}));
+    ASSERT_EQ(sink.calls[4].col, 2);
+    ASSERT_EQ(sink.calls[4].entries, (Entries{{"e1", -0.5}, {"g1", 1.0}}));
+
+    // Everything but the matrix entries is parsed as usual
+    ASSERT_TRUE(data->get_c() == expected->get_c());
+    ASSERT_TRUE(data->get_lb() == expected->get_lb());
+    ASSERT_TRUE(data->get_ub() == expected->get_ub());
+    ASSERT_TRUE(data->get_b_eq() == expected->get_b_eq());
+    ASSERT_TRUE(data->get_b_ineq() == expected->get_b_ineq());
+    ASSERT_EQ(data->get_A_eq().rows(), expected->get_A_eq().rows());
+    ASSERT_EQ(data->get_A_ineq().rows(), expected->get_A_ineq().rows());
+    ASSERT_EQ(data->get_A_ineq().cols(), 3);
+    ASSERT_EQ(data->get_A_eq().nonZeros(), 0);
+    ASSERT_EQ(data->get_A_ineq().nonZeros(), 0);
+}
+
+TEST_F(MPSParserTest, CoefficientSinkSeesEveryNonzero) {
+    for (int num_threads : {1, 2}) {
+        RecordingSink sink;
+        mps::ParseOptions options;
+        options.coefficient_sink = &sink;
+        options.num_threads = num_threads;
+        auto data = mps::parse_mps(valid_filename, options);
+
+        size_t entries = 0;
+        for (const auto& call : sink.calls) entries += call.entries.size();
+        ASSERT_EQ(entries, static_cast<size_t>(lp_data->get_A_eq().nonZeros() + lp_data->get_A_ineq().nonZeros()));
+        ASSERT_EQ(sink.calls.size(), static_cast<size_t>(lp_data->get_n_vars()));
+        ASSERT_EQ(data->get_A_ineq().nonZeros(), 0);
+    }
+}
+
+// Fails on the first column it receives
+class ThrowingSink : public mps::CoefficientSink {
+public:
+    void add_column(const mps::ParserState&, int, const int*, const double*, size_t) override {
+        throw std::runtime_error("sink failed");
+    }
+};
+
+TEST(MPSParserEdgeCaseTest, ParallelColumnsJoinWorkersWhenMergeThrows) {
+    // Several 64 KiB COLUMNS chunks, so workers are still running when the first merge throws
+    mps::MpsGeneratorOptions generator;
+    generator.rows = 500;
+    generator.columns = 20000;
+    generator.density = 0.01;
+    const std::string path = (std::filesystem::temp_directory_path() / "parallel_throw_test.mps").string();
+    mps::generate_mps_file(path, generator);
+
+    ThrowingSink sink;
+    mps::ParseOptions options;
+    options.coefficient_sink = &sink;
+    options.num_threads = 4;
+    ASSERT_THROW(mps::parse_mps(path, options), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(ParserStateTest, ArenaBatchesSmallAllocations) {
+    mps::ParserState arena_state;
+    mps::ParserState heap_state(std::pmr::new_delete_resource());
+    for (mps::ParserState* state : {&arena_state, &heap_state}) {
+        state->add_row("cost", 'N');
+        for (int i = 0; i < 1000; ++i) {
+            state->add_row("constraint_row_" + std::to_string(i), 'L');
+        }
+        for (int j = 0; j < 1000; ++j) {
+            const int col = state->add_column("variable_column_" + std::to_string(j));
+            state->add_coefficient(col, 1 + j, 1.0);
+        }
+    }
+
+    ASSERT_EQ(arena_state.get_num_rows(), 1001);
+    ASSERT_EQ(arena_state.get_col_name(999), "variable_column_999");
+    ASSERT_EQ(arena_state.get_objective_name(), "cost");
+    ASSERT_EQ(arena_state.copy_col_names().size(), 1000u);
+    ASSERT_GT(arena_state.get_allocation_stats().allocations, 0u);
+    ASSERT_LT(arena_state.get_allocation_stats().allocations * 4, heap_state.get_allocation_stats().allocations);
+}
+
+TEST_F(MPSParserTest, ParseWithCallerMemoryResource) {
+    std::pmr::unsynchronized_pool_resource pool;
+    mps::ParseOptions options;
+    options.memory_resource = &pool;
+    auto data = mps::parse_mps(valid_filename, options);
+    expect_lp_data_equal(*lp_data, *data);
+}
+
+TEST_F(MPSParserTest, SnapshotViewsMatchParsedModel) {
+    const std::string path = (std::filesystem::temp_directory_path() / "mps_parser_test.snap").string();
+    const uint64_t bytes = mps::save_lp_snapshot(*lp_data, path);
+    ASSERT_EQ(bytes, std::filesystem::file_size(path));
+
+    const mps::LpSnapshot snapshot(path);
+    ASSERT_EQ(snapshot.get_n_vars(), lp_data->get_n_vars());
+    ASSERT_TRUE(snapshot.get_c() == lp_data->get_c());
+    ASSERT_TRUE(snapshot.get_ub() == lp_data->get_ub());
+    ASSERT_TRUE(snapshot.get_b_ineq() == lp_data->get_b_ineq());
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(snapshot.get_A_ineq().valuePtr()) % 64, 0u);  // views into the mapping
+    ASSERT_EQ(snapshot.get_A_ineq().nonZeros(), lp_data->get_A_ineq().nonZeros());
+    ASSERT_EQ((Eigen::SparseMatrix<double>(snapshot.get_A_ineq()) - lp_data->get_A_ineq()).norm(), 0.0);
+    ASSERT_EQ(snapshot.get_col_name(3), lp_data->get_col_names()[3]);
+    ASSERT_THROW(snapshot.get_col_name(snapshot.get_n_vars()), std::out_of_range);
+    expect_lp_data_equal(*snapshot.to_lp_data(), *lp_data);
+
+    // A truncated or foreign file is rejected before any view is handed out
+    std::filesystem::resize_file(path, bytes - 64);
+    ASSERT_THROW(mps::LpSnapshot{path}, std::runtime_error);
+    std::ofstream(path) << "NAME          not a snapshot\n";
+    ASSERT_THROW(mps::LpSnapshot{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(LpSnapshotTest, RejectsCorruptArrays) {
+    // A_eq is 5 x 3 with row indices {3}, {1, 4}, {2}: distinctive byte patterns to corrupt
+    Eigen::SparseMatrix<double> A_eq(5, 3);
+    std::vector<Eigen::Triplet<double>> triplets{{3, 0, 1.0}, {1, 1, 2.0}, {4, 1, 3.0}, {2, 2, 4.0}};
+    A_eq.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::VectorXd c(3);
+    c << 1.25, -2.5, 3.75;
+    const mps::LpData lp(3, c, {Eigen::VectorXd::Zero(3), Eigen::VectorXd::Ones(3)}, A_eq, Eigen::VectorXd::Ones(5),
+                         Eigen::SparseMatrix<double>(0, 3), Eigen::VectorXd(0), 0.0,
+                         std::vector<std::string>{"x1", "x2", "x3"});
+    const std::string path = (std::filesystem::temp_directory_path() / "corrupt_test.snap").string();
+    mps::save_lp_snapshot(lp, path);
+    std::ifstream in(path, std::ios::binary);
+    const std::string original((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    ASSERT_NO_THROW(mps::LpSnapshot{path});
+
+    auto bytes_of = [](const auto& values) {
+        return std::string(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(values[0]));
+    };
+    // Replaces the first occurrence of one run of values with another and writes the file
+    auto write_with = [&](const auto& from, const auto& to) {
+        const size_t position = original.find(bytes_of(from));
+        ASSERT_NE(position, std::string::npos);
+        std::string bytes = original;
+        bytes.replace(position, bytes_of(from).size(), bytes_of(to));
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    };
+    // Damage only a full pass can see: opening succeeds, validate() and to_lp_data() throw
+    auto opens_but_fails_validation = [&](const auto& from, const auto& to) {
+        write_with(from, to);
+        const mps::LpSnapshot snapshot(path);
+        ASSERT_THROW(snapshot.validate(), std::runtime_error);
+        ASSERT_THROW(snapshot.to_lp_data(), std::runtime_error);
+    };
+    // Damage the constant-time checks on opening already reject
+    auto reopen_with = [&](const auto& from, const auto& to) {
+        write_with(from, to);
+        ASSERT_THROW(mps::LpSnapshot{path}, std::runtime_error);
+    };
+    {
+        const mps::LpSnapshot snapshot(path);
+        ASSERT_NO_THROW(snapshot.validate());
+    }
+    using Indices = std::array<int32_t, 4>;
+    using Offsets = std::array<uint64_t, 4>;
+    opens_but_fails_validation(Indices{0, 1, 3, 4}, Indices{0, 3, 1, 4});   // column offsets decrease
+    opens_but_fails_validation(Indices{3, 1, 4, 2}, Indices{3, 1, 5, 2});   // row index past the last row
+    opens_but_fails_validation(Indices{3, 1, 4, 2}, Indices{3, 4, 1, 2});   // row indices unsorted in a column
+    opens_but_fails_validation(Offsets{0, 2, 4, 6}, Offsets{0, 4, 2, 6});   // name offsets decrease
+    {
+        const mps::LpSnapshot snapshot(path);
+        ASSERT_THROW(snapshot.get_col_name(1), std::runtime_error);  // each name is still bounds-checked
+    }
+    reopen_with(Indices{0, 1, 3, 4}, Indices{1, 1, 3, 4});    // column offsets do not start at 0
+    reopen_with(Indices{0, 1, 3, 4}, Indices{0, 1, 3, 3});    // last column offset is not nnz
+    reopen_with(Offsets{0, 2, 4, 6}, Offsets{0, 2, 4, 99});   // name past the name blob
+
+    // A name offset count whose byte size wraps around to 8 must not pass the bounds check
+    const uint64_t names_offset = original.find(bytes_of(Offsets{0, 2, 4, 6}));
+    ASSERT_NE(names_offset, std::string::npos);
+    reopen_with(std::array<uint64_t, 2>{names_offset, 4}, std::array<uint64_t, 2>{names_offset, (uint64_t{1} << 61) + 1});
+
+    std::filesystem::remove(path);
+}
+
+TEST(LpDataTest, RvalueConstructorTakesOwnershipWithoutCopying) {
+    Eigen::VectorXd c = Eigen::VectorXd::Ones(2);
+    Eigen::SparseMatrix<double> A_eq(1, 2);
+    A_eq.insert(0, 1) = 3.0;
+    A_eq.makeCompressed();
+    Eigen::SparseMatrix<double> A_ineq(1, 2);
+    A_ineq.insert(0, 0) = -1.0;
+    A_ineq.makeCompressed();
+    std::vector<std::string> col_names = {"x1", "x2"};
+
+    const double* c_data = c.data();
+    const double* A_eq_values = A_eq.valuePtr();
+    const double* A_ineq_values = A_ineq.valuePtr();
+    const std::string* names_data = col_names.data();
+
+    mps::LpData lp(2, std::move(c), {Eigen::VectorXd::Zero(2), Eigen::VectorXd::Ones(2)},
+                   std::move(A_eq), Eigen::VectorXd::Ones(1), std::move(A_ineq), Eigen::VectorXd::Zero(1),
+                   0.0, std::move(col_names));
+
+    ASSERT_EQ(lp.get_c().data(), c_data);
+    ASSERT_EQ(lp.get_A_eq().valuePtr(), A_eq_values);
+    ASSERT_EQ(lp.get_A_ineq().valuePtr(), A_ineq_values);
+    ASSERT_EQ(lp.get_col_names().data(), names_data);
+    ASSERT_EQ(lp.get_A_eq().coeff(0, 1), 3.0);
+}
+
+TEST(ConversionCacheTest, HashFileDependsOnEveryByte) {
+    const std::string path = (std::filesystem::temp_directory_path() / "conversion_cache_hash.mps").string();
+    // Larger than one read chunk, with a length that is not a multiple of the stripe size
+    std::string content(3 * 1024 * 1024 + 7, 'x');
+    std::ofstream(path, std::ios::binary) << content;
+    const std::string original = mps::hash_file(path);
+    ASSERT_EQ(original.size(), 16u);
+    ASSERT_EQ(mps::hash_file(path), original);
+
+    content[2 * 1024 * 1024 + 5] = 'y';
+    std::ofstream(path, std::ios::binary) << content;
+    ASSERT_NE(mps::hash_file(path), original);
+
+    content.pop_back();
+    std::ofstream(path, std::ios::binary) << content;
+    ASSERT_NE(mps::hash_file(path), original);
+
+    std::remove(path.c_str());
+    ASSERT_THROW(mps::hash_file(path), std::runtime_error);
+}
+
+TEST(ConversionCacheTest, MatchesHashAndConverterVersion) {
+    const auto dir = std::filesystem::temp_directory_path() / "conversion_cache_dir";
+    std::filesystem::create_directories(dir);
+    const std::string key = "parquet;codec=none;row_group_size=1048576";
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", key));
+
+    std::ofstream(dir / "metadata.json") << "{\"source_hash\": \"0123456789abcdef\", \"converter_version\": \""
+                                         << mps::kConverterVersion << "\", \"conversion_key\": \"" << key << "\"}";
+    ASSERT_TRUE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", key));
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "fedcba9876543210", key));
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", "parquet;codec=zstd;row_group_size=1048576"));
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", "parquet;codec=none;row_group_size=4096"));
+
+    // Conversions without a key were written by an older converter
+    std::ofstream(dir / "metadata.json") << "{\"source_hash\": \"0123456789abcdef\", \"converter_version\": \""
+                                         << mps::kConverterVersion << "\", \"output_layout\": \"parquet\"}";
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", key));
+
+    std::ofstream(dir / "metadata.json") << "{\"source_hash\": \"0123456789abcdef\", \"converter_version\": \"old\", "
+                                         << "\"conversion_key\": \"" << key << "\"}";
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", key));
+
+    std::ofstream(dir / "metadata.json") << "{truncated";
+    ASSERT_FALSE(mps::is_cached_conversion(dir.string(), "0123456789abcdef", key));
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(CompressedInputTest, InstanceNamesIgnoreCompressionSuffix) {
+    ASSERT_EQ(mps::instance_name_from_path("dir/50v-10.mps.gz"), "50v-10");
+    ASSERT_EQ(mps::instance_name_from_path("50v-10.mps.zst"), "50v-10");
+    ASSERT_EQ(mps::instance_name_from_path("/a/b/50v-10.mps"), "50v-10");
+    ASSERT_TRUE(mps::is_mps_file_name("dir/50v-10.mps.bz2"));
+    ASSERT_TRUE(mps::is_mps_file_name("50v-10.mps"));
+    ASSERT_FALSE(mps::is_mps_file_name("50v-10.gz"));
+    ASSERT_FALSE(mps::is_mps_file_name("notes.txt"));
+}
+
+TEST_F(MPSParserTest, PlainInputIsNotCompressed) {
+    ASSERT_EQ(mps::detect_compression(valid_filename), mps::Compression::None);
+    ASSERT_THROW(mps::detect_compression(invalid_filename), std::runtime_error);
+}
+
+#ifdef MPS_HAVE_ZLIB
+TEST_F(MPSParserTest, GzipInputMatchesPlainFile) {
+    std::ifstream plain(valid_filename, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(plain)), std::istreambuf_iterator<char>());
+    const std::string path = (std::filesystem::temp_directory_path() / "compressed_input_test.mps.gz").string();
+    // Two gzip members, as produced by concatenating .gz files; the split is mid-line
+    const size_t split = content.size() / 3;
+    gzFile gz = gzopen(path.c_str(), "wb");
+    ASSERT_NE(gz, nullptr);
+    gzwrite(gz, content.data(), static_cast<unsigned>(split));
+    gzclose(gz);
+    gz = gzopen(path.c_str(), "ab");
+    gzwrite(gz, content.data() + split, static_cast<unsigned>(content.size() - split));
+    gzclose(gz);
+
+    ASSERT_EQ(mps::detect_compression(path), mps::Compression::Gzip);
+    ASSERT_EQ(mps::count_lines(path), 6307);
+    ASSERT_EQ(mps::read_problem_name(path), "50v-10");
+    for (auto backend : {mps::ReaderBackend::Stream, mps::ReaderBackend::Mmap}) {
+        mps::ParseOptions options;
+        options.backend = backend;
+        auto data = mps::parse_mps(path, options);
+        ASSERT_NE(data, nullptr);
+        expect_lp_data_equal(*lp_data, *data);
+    }
+
+    // Cut the second member short: the reader must report it rather than stop early
+    std::ifstream compressed(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(compressed)), std::istreambuf_iterator<char>());
+    compressed.close();
+    bytes.resize(bytes.size() - 64);
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    ASSERT_THROW(mps::parse_mps(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+#endif
+
+#ifdef MPS_HAVE_BZIP2
+TEST_F(MPSParserTest, Bzip2InputMatchesPlainFile) {
+    std::ifstream plain(valid_filename, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(plain)), std::istreambuf_iterator<char>());
+    std::string bytes(content.size() + content.size() / 100 + 600, '\0');
+    unsigned int compressed_size = static_cast<unsigned int>(bytes.size());
+    ASSERT_EQ(BZ2_bzBuffToBuffCompress(bytes.data(), &compressed_size, content.data(),
+                                       static_cast<unsigned int>(content.size()), 9, 0, 0),
+              BZ_OK);
+    bytes.resize(compressed_size);
+    const std::string path = (std::filesystem::temp_directory_path() / "compressed_input_test.mps.bz2").string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+    ASSERT_EQ(mps::detect_compression(path), mps::Compression::Bzip2);
+    ASSERT_EQ(mps::read_problem_name(path), "50v-10");
+    for (auto backend : {mps::ReaderBackend::Stream, mps::ReaderBackend::Mmap}) {
+        mps::ParseOptions options;
+        options.backend = backend;
+        auto data = mps::parse_mps(path, options);
+        ASSERT_NE(data, nullptr);
+        expect_lp_data_equal(*lp_data, *data);
+    }
+
+    // A stream cut short, and one whose block fails its CRC
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 64);
+    ASSERT_THROW(mps::parse_mps(path), std::runtime_error);
+    bytes[bytes.size() / 2] ^= 0x5a;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    ASSERT_THROW(mps::parse_mps(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+#endif
+
+#ifdef MPS_HAVE_ZSTD
+TEST_F(MPSParserTest, ZstdInputMatchesPlainFile) {
+    std::ifstream plain(valid_filename, std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(plain)), std::istreambuf_iterator<char>());
+    // Two frames, as produced by concatenating .zst files; the frames carry checksums
+    const size_t split = content.size() / 3;
+    std::string bytes;
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    ASSERT_NE(context, nullptr);
+    ZSTD_CCtx_setParameter(context, ZSTD_c_checksumFlag, 1);
+    for (const std::string_view part : {std::string_view(content).substr(0, split),
+                                        std::string_view(content).substr(split)}) {
+        std::string frame(ZSTD_compressBound(part.size()), '\0');
+        const size_t frame_size = ZSTD_compress2(context, frame.data(), frame.size(), part.data(), part.size());
+        ASSERT_FALSE(ZSTD_isError(frame_size));
+        bytes.append(frame.data(), frame_size);
+    }
+    ZSTD_freeCCtx(context);
+    const std::string path = (std::filesystem::temp_directory_path() / "compressed_input_test.mps.zst").string();
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+
+    ASSERT_EQ(mps::detect_compression(path), mps::Compression::Zstd);
+    ASSERT_EQ(mps::count_lines(path), 6307);
+    for (auto backend : {mps::ReaderBackend::Stream, mps::ReaderBackend::Mmap}) {
+        mps::ParseOptions options;
+        options.backend = backend;
+        auto data = mps::parse_mps(path, options);
+        ASSERT_NE(data, nullptr);
+        expect_lp_data_equal(*lp_data, *data);
+    }
+
+    // A frame cut short, and one that fails its checksum
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 64);
+    ASSERT_THROW(mps::parse_mps(path), std::runtime_error);
+    bytes[bytes.size() - 2] ^= 0x5a;
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes;
+    ASSERT_THROW(mps::parse_mps(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+#endif
+
+TEST(MpsGeneratorTest, GeneratedModelParsesWithRequestedShape) {
+    mps::MpsGeneratorOptions options;
+    options.rows = 300;
+    options.columns = 700;
+    options.density = 0.02;
+    options.eq_weight = 1.0;
+    options.le_weight = 0.0;
+    options.ge_weight = 1.0;
+    options.range_density = 0.1;
+    options.integer_fraction = 0.5;
+    options.marker_block = 25;
+    options.name_length = 12;
+    const std::string path = (std::filesystem::temp_directory_path() / "mps_generator_test.mps").string();
+    const mps::MpsGeneratorStats stats = mps::generate_mps_file(path, options);
+
+    auto data = mps::parse_mps(path);
+    ASSERT_EQ(data->get_n_vars(), 700);
+    ASSERT_EQ(data->get_A_eq().rows() + data->get_A_ineq().rows(), 300);
+    ASSERT_EQ(data->get_A_eq().nonZeros() + data->get_A_ineq().nonZeros(), stats.nonzeros);
+    ASSERT_EQ(data->get_col_names()[0].size(), 12u);
+    ASSERT_EQ(std::filesystem::file_size(path), static_cast<uintmax_t>(stats.bytes));
+    ASSERT_EQ(mps::count_lines(path), stats.lines);
+    std::remove(path.c_str());
+}
+
+TEST(MpsGeneratorTest, SeedDeterminesOutput) {
+    mps::MpsGeneratorOptions options;
+    options.rows = 50;
+    options.columns = 80;
+    options.density = 0.1;
+    std::ostringstream first, second, other;
+    mps::generate_mps(first, options);
+    mps::generate_mps(second, options);
+    options.seed = 7;
+    mps::generate_mps(other, options);
+    ASSERT_EQ(first.str(), second.str());
+    ASSERT_NE(first.str(), other.str());
+
+    options.density = 1.5;
+    ASSERT_THROW(mps::generate_mps(other, options), std::invalid_argument);
+}
+
+TEST(CliArgsTest, ParseIntOptionChecksFormatAndRange) {
+    ASSERT_EQ(mps::parse_int_option("--threads", "0", 0), 0);
+    ASSERT_EQ(mps::parse_int_option("--threads", "16", 0), 16);
+    ASSERT_EQ(mps::parse_int_option<uint64_t>("--seed", "18446744073709551615", 0), UINT64_MAX);
+    ASSERT_THROW(mps::parse_int_option("--threads", "-1", 0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--threads", "four", 0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--threads", "4x", 0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--threads", "", 0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--jobs", "0", 1u), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option<uint64_t>("--seed", "-1", 0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--pairs-per-line", "3", 1, 2), std::invalid_argument);
+    ASSERT_THROW(mps::parse_int_option("--threads", "99999999999", 0), std::invalid_argument);
+}
+
+TEST(CliArgsTest, ParseDoubleOptionChecksFormatAndRange) {
+    ASSERT_EQ(mps::parse_double_option("--density", "0.5", 0.0, 1.0), 0.5);
+    ASSERT_EQ(mps::parse_double_option("--density", "1", 0.0, 1.0), 1.0);
+    ASSERT_EQ(mps::parse_double_option("--density", "2.5e-3", 0.0, 1.0), 0.0025);
+    ASSERT_EQ(mps::parse_double_option("--row-mix", "1e6", 0.0), 1e6);
+    ASSERT_THROW(mps::parse_double_option("--density", "0.5abc", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", "abc", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", "", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", " 0.5", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", "1.5", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", "-0.1", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--density", "nan", 0.0, 1.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--row-mix", "inf", 0.0), std::invalid_argument);
+    ASSERT_THROW(mps::parse_double_option("--row-mix", "1e999", 0.0), std::invalid_argument);
+}
@@ -1,12 +1,17 @@
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <arrow/io/api.h>
 #include <arrow/result.h>
 #include <parquet/arrow/reader.h>
 #include <parquet/exception.h>
+#include <nlohmann/json.hpp>
 #include <arrow/testing/gtest_util.h>
+#include "parquet_reader.h"
 #include "parquet_writer.h"
 #include "mps_parser.h"
+#include "conversion_cache.h"
 
 namespace fs = std::filesystem;
 
@@ -140,6 +145,143 @@ TEST_F(ParquetWriterTest, SaveSparseMatrix) {
     auto result = mps::save_coo_matrix(A_eq, filename);
     ASSERT_OK(result);
     verify_coo_matrix_file(filename, A_eq);
+
+    // int32 indices: the row column is Eigen's inner index, wrapped without a copy
+    mps::OutputOptions narrow;
+    narrow.narrow_indices = true;
+    ASSERT_OK(mps::save_coo_matrix(A_eq, filename, narrow));
+    ASSERT_OK_AND_ASSIGN(auto table, mps::read_table(filename));
+    ASSERT_EQ(table->schema()->ToString(), "row: int32\ncol: int32\ndata: double");
+    ASSERT_OK_AND_ASSIGN(auto loaded, mps::load_coo_matrix(filename, A_eq.rows(), A_eq.cols()));
+    ASSERT_EQ(Eigen::MatrixXd(loaded), Eigen::MatrixXd(A_eq));
+}
+
+TEST_F(ParquetWriterTest, SaveUncompressedSparseMatrix) {
+    // insert() without makeCompressed() leaves gaps in the storage
+    Eigen::SparseMatrix<double> matrix(3, 4);
+    matrix.reserve(Eigen::VectorXi::Constant(4, 2));
+    matrix.insert(2, 0) = 1.5;
+    matrix.insert(0, 1) = -2.0;
+    matrix.insert(1, 1) = 4.0;
+    matrix.insert(0, 3) = 7.0;
+    ASSERT_FALSE(matrix.isCompressed());
+
+    std::string filename = (test_dir / "uncompressed.parquet").string();
+    auto result = mps::save_coo_matrix(matrix, filename);
+    ASSERT_OK(result);
+    verify_coo_matrix_file(filename, matrix);
+
+    mps::OutputOptions narrow;
+    narrow.narrow_indices = true;
+    ASSERT_OK(mps::save_coo_matrix(matrix, filename, narrow));
+    ASSERT_OK_AND_ASSIGN(auto loaded, mps::load_coo_matrix(filename, 3, 4));
+    ASSERT_EQ(Eigen::MatrixXd(loaded), Eigen::MatrixXd(matrix));
+}
+
+TEST_F(ParquetWriterTest, SaveWithWriteOptions) {
+    mps::OutputOptions options;
+    options.row_group_size = 2;
+    options.codec = mps::parse_compression_codec("zstd");
+    options.compression_level = 3;
+    options.parquet.dictionary = false;
+    options.parquet.byte_stream_split = true;
+
+    const auto& A_eq = test_data->get_A_eq();
+    std::string filename = (test_dir / "A_eq_options.parquet").string();
+    ASSERT_OK(mps::save_coo_matrix(A_eq, filename, options));
+    verify_coo_matrix_file(filename, A_eq);
+
+    ASSERT_OK_AND_ASSIGN(auto infile, arrow::io::ReadableFile::Open(filename));
+    std::unique_ptr<parquet::arrow::FileReader> reader;
+    PARQUET_ASSIGN_OR_THROW(reader, parquet::arrow::OpenFile(infile, arrow::default_memory_pool()));
+    auto metadata = reader->parquet_reader()->metadata();
+    ASSERT_EQ(metadata->num_row_groups(), 2);  // 4 nonzeros, 2 rows per group
+    ASSERT_EQ(metadata->RowGroup(0)->ColumnChunk(0)->compression(), arrow::Compression::ZSTD);
+
+    ASSERT_THROW(mps::parse_compression_codec("brotli9000"), std::invalid_argument);
+}
+
+TEST_F(ParquetWriterTest, ConversionKeyCoversEveryWriteSetting) {
+    const mps::OutputOptions defaults;
+    const std::string key = mps::conversion_key(defaults);
+    auto differs = [&](auto change) {
+        mps::OutputOptions options;
+        change(options);
+        return mps::conversion_key(options) != key;
+    };
+    ASSERT_TRUE(differs([](auto& o) { o.row_group_size = 4096; }));
+    ASSERT_TRUE(differs([](auto& o) { o.codec = mps::CompressionCodec::Zstd; }));
+    ASSERT_TRUE(differs([](auto& o) { o.compression_level = 3; }));
+    ASSERT_TRUE(differs([](auto& o) { o.parquet.dictionary = false; }));
+    ASSERT_TRUE(differs([](auto& o) { o.parquet.byte_stream_split = true; }));
+    ASSERT_TRUE(differs([](auto& o) { o.snapshot = true; }));
+    ASSERT_TRUE(differs([](auto& o) { o.format = mps::OutputFormat::Feather; }));
+    ASSERT_TRUE(differs([](auto& o) { o.matrix_layout = mps::MatrixLayout::Csc; }));
+    ASSERT_TRUE(differs([](auto& o) { o.narrow_indices = true; }));
+    ASSERT_NE(mps::conversion_key(defaults, true), key);
+    ASSERT_FALSE(differs([](auto& o) { o.concurrent_files = true; }));
+    ASSERT_FALSE(differs([](auto& o) { o.source_hash = "0123456789abcdef"; }));
+
+    mps::OutputOptions options;
+    options.source_hash = "0123456789abcdef";
+    options.codec = mps::CompressionCodec::Zstd;
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_key", options);
+    ASSERT_TRUE(mps::is_cached_conversion(output_dir, options.source_hash, mps::conversion_key(options)));
+    options.codec = mps::CompressionCodec::Uncompressed;
+    ASSERT_FALSE(mps::is_cached_conversion(output_dir, options.source_hash, mps::conversion_key(options)));
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, WriteStatsCountTheFile) {
+    for (auto format : {mps::OutputFormat::Parquet, mps::OutputFormat::Feather}) {
+        mps::OutputOptions options;
+        options.format = format;
+        options.row_group_size = 1;  // several row groups (record batches), so several writes
+        const std::string filename = (test_dir / mps::table_file_name("A_eq_stats", format)).string();
+        mps::SaveFileStats stats;
+        ASSERT_OK(mps::save_coo_matrix(test_data->get_A_eq(), filename, options, &stats));
+
+        // The output stream is wrapped to time its writes; the byte count is what it wrote
+        ASSERT_EQ(stats.bytes, fs::file_size(filename));
+        ASSERT_GT(stats.write_seconds, 0.0);
+        ASSERT_GE(stats.encode_seconds, 0.0);
+        auto table = mps::read_table(filename);
+        ASSERT_OK(table.status());
+        ASSERT_EQ((*table)->num_rows(), test_data->get_A_eq().nonZeros());
+    }
+}
+
+TEST_F(ParquetWriterTest, RejectsNonPositiveRowGroupSize) {
+    mps::OutputOptions options;
+    options.row_group_size = 0;
+    ASSERT_FALSE(mps::save_vector(test_data->get_c(), "c", (test_dir / "c.parquet").string(), options).ok());
+    options.row_group_size = -5;
+    ASSERT_THROW(mps::save_lp_to_parquet(*test_data, "test_instance_row_groups", options), std::invalid_argument);
+    ASSERT_FALSE(fs::exists(mps::parquet_output_dir("test_instance_row_groups")));
+}
+
+TEST_F(ParquetWriterTest, SaveBoundsWithoutVariables) {
+    const std::string filename = (test_dir / "bounds.parquet").string();
+    ASSERT_OK(mps::save_bounds(Eigen::VectorXd(0), Eigen::VectorXd(0), filename));
+    ASSERT_OK_AND_ASSIGN(auto table, mps::read_table(filename));
+    ASSERT_EQ(table->num_rows(), 0);
+    ASSERT_EQ(table->schema()->ToString(), "lb: double\nub: double");
+
+    // The whole model round-trips: c, the bounds and both constraint blocks come back empty
+    mps::LpData empty(0, Eigen::VectorXd(0), {Eigen::VectorXd(0), Eigen::VectorXd(0)},
+                      Eigen::SparseMatrix<double>(0, 0), Eigen::VectorXd(0),
+                      Eigen::SparseMatrix<double>(0, 0), Eigen::VectorXd(0), 1.5, std::vector<std::string>());
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(empty, "no_vars_test");
+    ASSERT_TRUE(fs::exists(fs::path(output_dir) / "c.parquet"));
+    auto loaded = mps::load_lp_from_parquet(output_dir);
+    ASSERT_EQ(loaded->get_n_vars(), 0);
+    ASSERT_EQ(loaded->get_c().size(), 0);
+    ASSERT_EQ(loaded->get_lb().size(), 0);
+    ASSERT_EQ(loaded->get_A_eq().rows(), 0);
+    ASSERT_EQ(loaded->get_A_ineq().cols(), 0);
+    ASSERT_TRUE(loaded->get_col_names().empty());
+    ASSERT_DOUBLE_EQ(loaded->get_obj_offset(), 1.5);
+    fs::remove_all(output_dir);
 }
 
 TEST_F(ParquetWriterTest, SaveFullLpData) {
@@ -196,6 +338,28 @@ TEST_F(ParquetWriterTest, SaveFullLpData) {
     fs::remove_all(output_dir);
 }
 
+TEST_F(ParquetWriterTest, SaveFullLpDataConcurrently) {
+    mps::OutputOptions options;
+    options.concurrent_files = true;
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_concurrent", options);
+
+    verify_vector_file((fs::path(output_dir) / "c.parquet").string(), test_data->get_c(), "c");
+    verify_vector_file((fs::path(output_dir) / "b_eq.parquet").string(), test_data->get_b_eq(), "b_eq");
+    verify_vector_file((fs::path(output_dir) / "b_ineq.parquet").string(), test_data->get_b_ineq(), "b_ineq");
+    verify_coo_matrix_file((fs::path(output_dir) / "A_eq_coo.parquet").string(), test_data->get_A_eq());
+    verify_coo_matrix_file((fs::path(output_dir) / "A_ineq_coo.parquet").string(), test_data->get_A_ineq());
+
+    // Per-file timings are recorded next to the total
+    std::ifstream metadata_file(fs::path(output_dir) / "metadata.json");
+    std::string metadata((std::istreambuf_iterator<char>(metadata_file)), std::istreambuf_iterator<char>());
+    ASSERT_NE(metadata.find("\"save_files\""), std::string::npos);
+    ASSERT_NE(metadata.find("\"A_ineq_coo.parquet\""), std::string::npos);
+    ASSERT_EQ(metadata.find("\"save_file_times_seconds\""), std::string::npos);  // save_files holds the times
+    ASSERT_GT(save_time, 0.0);
+
+    fs::remove_all(output_dir);
+}
+
 TEST_F(ParquetWriterTest, SaveEmptyMatrices) {
     // Create an LP with no constraints
     int n_vars = 2;
@@ -232,4 +396,252 @@ TEST_F(ParquetWriterTest, SaveEmptyMatrices) {
 
     // Clean up test directory
     fs::remove_all(output_dir);
-} 
\ No newline at end of file
+}
+
+TEST_F(ParquetWriterTest, LoadRoundTrip) {
+    mps::OutputOptions options;
+    options.row_group_size = 1;  // several row groups per file
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_load", options);
+
+    auto loaded = mps::load_lp_from_parquet(output_dir);
+
+    ASSERT_EQ(loaded->get_n_vars(), test_data->get_n_vars());
+    ASSERT_EQ(loaded->get_c(), test_data->get_c());
+    ASSERT_EQ(loaded->get_lb(), test_data->get_lb());
+    ASSERT_EQ(loaded->get_ub(), test_data->get_ub());
+    ASSERT_EQ(loaded->get_b_eq(), test_data->get_b_eq());
+    ASSERT_EQ(loaded->get_b_ineq(), test_data->get_b_ineq());
+    ASSERT_DOUBLE_EQ(loaded->get_obj_offset(), test_data->get_obj_offset());
+    ASSERT_EQ(loaded->get_col_names(), test_data->get_col_names());
+
+    ASSERT_TRUE(loaded->get_A_eq().isCompressed());
+    ASSERT_EQ(loaded->get_A_eq().rows(), test_data->get_A_eq().rows());
+    ASSERT_EQ(loaded->get_A_eq().cols(), test_data->get_A_eq().cols());
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_eq()), Eigen::MatrixXd(test_data->get_A_eq()));
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(test_data->get_A_ineq()));
+
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, FeatherRoundTrip) {
+    for (mps::CompressionCodec codec : {mps::CompressionCodec::Uncompressed, mps::CompressionCodec::Lz4}) {
+        mps::OutputOptions options;
+        options.format = mps::OutputFormat::Feather;
+        options.codec = codec;
+        options.row_group_size = 1;  // several record batches per file
+        auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_feather", options);
+
+        ASSERT_TRUE(fs::exists(fs::path(output_dir) / "A_eq_coo.feather"));
+        ASSERT_FALSE(fs::exists(fs::path(output_dir) / "A_eq_coo.parquet"));
+        auto table = mps::read_table((fs::path(output_dir) / "A_ineq_coo.feather").string());
+        ASSERT_OK(table.status());
+        ASSERT_EQ((*table)->schema()->ToString(), "row: int64\ncol: int64\ndata: double");
+
+        auto loaded = mps::load_lp_from_parquet(output_dir);
+        ASSERT_EQ(loaded->get_c(), test_data->get_c());
+        ASSERT_EQ(loaded->get_lb(), test_data->get_lb());
+        ASSERT_EQ(loaded->get_ub(), test_data->get_ub());
+        ASSERT_EQ(loaded->get_b_eq(), test_data->get_b_eq());
+        ASSERT_EQ(loaded->get_b_ineq(), test_data->get_b_ineq());
+        ASSERT_EQ(loaded->get_col_names(), test_data->get_col_names());
+        ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_eq()), Eigen::MatrixXd(test_data->get_A_eq()));
+        ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(test_data->get_A_ineq()));
+
+        // Switching back to Parquet replaces the Feather tables
+        mps::save_lp_to_parquet(*test_data, "test_instance_feather");
+        ASSERT_FALSE(fs::exists(fs::path(output_dir) / "A_eq_coo.feather"));
+        ASSERT_EQ(mps::load_lp_from_parquet(output_dir)->get_c(), test_data->get_c());
+        fs::remove_all(output_dir);
+    }
+
+    mps::OutputOptions snappy;
+    snappy.format = mps::OutputFormat::Feather;
+    snappy.codec = mps::CompressionCodec::Snappy;
+    ASSERT_THROW(mps::save_lp_to_parquet(*test_data, "test_instance_feather", snappy), std::invalid_argument);
+}
+
+TEST_F(ParquetWriterTest, CompressedLayoutRoundTrip) {
+    for (mps::MatrixLayout layout : {mps::MatrixLayout::Csc, mps::MatrixLayout::Csr}) {
+        for (bool narrow : {false, true}) {
+            mps::OutputOptions options;
+            options.matrix_layout = layout;
+            options.narrow_indices = narrow;
+            options.row_group_size = 1;
+            auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_layout", options);
+
+            const std::string table = mps::matrix_table_name("eq", layout);
+            ASSERT_FALSE(fs::exists(fs::path(output_dir) / "A_eq_coo.parquet"));
+            auto data = mps::read_table((fs::path(output_dir) / (table + ".parquet")).string());
+            auto indptr = mps::read_table((fs::path(output_dir) / (table + "_indptr.parquet")).string());
+            ASSERT_OK(data.status());
+            ASSERT_OK(indptr.status());
+            const std::string index_type = narrow ? "int32" : "int64";
+            ASSERT_EQ((*data)->schema()->ToString(), "indices: " + index_type + "\ndata: double");
+            ASSERT_EQ((*indptr)->schema()->ToString(), "indptr: " + index_type);
+            const auto& A_eq = test_data->get_A_eq();
+            ASSERT_EQ((*data)->num_rows(), A_eq.nonZeros());
+            ASSERT_EQ((*indptr)->num_rows(), (layout == mps::MatrixLayout::Csc ? A_eq.cols() : A_eq.rows()) + 1);
+
+            auto loaded = mps::load_lp_from_parquet(output_dir);
+            ASSERT_TRUE(loaded->get_A_eq().isCompressed());
+            ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_eq()), Eigen::MatrixXd(A_eq));
+            ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(test_data->get_A_ineq()));
+            ASSERT_EQ(loaded->get_b_eq(), test_data->get_b_eq());
+            fs::remove_all(output_dir);
+        }
+    }
+
+    // Offsets that disagree with the matrix shape are rejected
+    mps::OutputOptions options;
+    options.matrix_layout = mps::MatrixLayout::Csc;
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(*test_data, "test_instance_layout", options);
+    const std::string base = (fs::path(output_dir) / "A_eq_csc").string();
+    ASSERT_OK(mps::load_compressed_matrix(base + ".parquet", base + "_indptr.parquet", mps::MatrixLayout::Csc, 2, 3)
+                  .status());
+    ASSERT_FALSE(mps::load_compressed_matrix(base + ".parquet", base + "_indptr.parquet", mps::MatrixLayout::Csc, 2, 4)
+                     .ok());
+    ASSERT_FALSE(mps::load_compressed_matrix(base + ".parquet", base + "_indptr.parquet", mps::MatrixLayout::Csc, 1, 3)
+                     .ok());
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, LoadWithoutConstraints) {
+    int n_vars = 2;
+    Eigen::VectorXd c(n_vars);
+    c << 1.0, -1.0;
+    Eigen::VectorXd lb = Eigen::VectorXd::Zero(n_vars);
+    Eigen::VectorXd ub = Eigen::VectorXd::Ones(n_vars);
+
+    mps::LpData data(n_vars, c, std::make_pair(lb, ub),
+                     Eigen::SparseMatrix<double>(0, n_vars), Eigen::VectorXd(0),
+                     Eigen::SparseMatrix<double>(0, n_vars), Eigen::VectorXd(0),
+                     2.5, std::vector<std::string>{"x1", "x2"});
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(data, "empty_load_test");
+
+    auto loaded = mps::load_lp_from_parquet(output_dir);
+    ASSERT_EQ(loaded->get_c(), c);
+    ASSERT_EQ(loaded->get_A_eq().rows(), 0);
+    ASSERT_EQ(loaded->get_A_eq().cols(), n_vars);
+    ASSERT_EQ(loaded->get_b_ineq().size(), 0);
+    ASSERT_DOUBLE_EQ(loaded->get_obj_offset(), 2.5);
+
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, ParsedModelWithoutEqualityRowsRoundTrips) {
+    const fs::path mps_path = test_dir / "no_eq_test.mps";
+    {
+        std::ofstream out(mps_path);
+        out << "NAME          NOEQ\n"
+               "ROWS\n"
+               " N  cost\n L  l1\n G  g1\n"
+               "COLUMNS\n"
+               "    x1        cost      1          l1        2\n"
+               "    x2        g1        3\n"
+               "RHS\n"
+               "    rhs       l1        4          g1        1\n"
+               "ENDATA\n";
+    }
+    auto parsed = mps::parse_mps(mps_path.string());
+    ASSERT_EQ(parsed->get_A_eq().rows(), 0);
+    ASSERT_EQ(parsed->get_A_eq().cols(), parsed->get_n_vars());
+
+    auto [output_dir, save_time] = mps::save_lp_to_parquet(*parsed, "no_eq_instance");
+    auto loaded = mps::load_lp_from_parquet(output_dir);
+    ASSERT_EQ(loaded->get_A_eq().rows(), parsed->get_A_eq().rows());
+    ASSERT_EQ(loaded->get_A_eq().cols(), parsed->get_A_eq().cols());
+    ASSERT_EQ(loaded->get_A_ineq().rows(), parsed->get_A_ineq().rows());
+    ASSERT_EQ(loaded->get_A_ineq().cols(), parsed->get_A_ineq().cols());
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(parsed->get_A_ineq()));
+    ASSERT_EQ(loaded->get_b_eq().size(), 0);
+
+    // The names live in their own table, not in metadata.json
+    ASSERT_TRUE(fs::exists(fs::path(output_dir) / "col_names.parquet"));
+    ASSERT_EQ(loaded->get_col_names(), parsed->get_col_names());
+    std::ifstream metadata_file(fs::path(output_dir) / "metadata.json");
+    const std::string metadata((std::istreambuf_iterator<char>(metadata_file)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(metadata.find("\"col_names\":"), std::string::npos);
+
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, StreamedConversionLoadsLikeParsedModel) {
+    const fs::path mps_path = test_dir / "stream_test.mps";
+    {
+        std::ofstream out(mps_path);
+        out << "NAME          STREAM\n"
+               "ROWS\n"
+               " N  cost\n G  g1\n L  l1\n E  e1\n G  g2\n"
+               "COLUMNS\n"
+               "    x1        cost      1.5        g1        2\n"
+               "    x1        e1        4          e1        5\n"
+               "    x1        g2        3          l1        9\n"
+               "    x2        cost      -1         l1        7.25\n"
+               "    x3        e1        -0.5       g1        1\n"
+               "    x1        g1        6          l1        -2\n"
+               "    x1        g2        8\n"
+               "RHS\n"
+               "    rhs       g1        10         e1        3\n"
+               "BOUNDS\n"
+               " UP bnd       x1        4\n"
+               "ENDATA\n";
+    }
+    // x1 reappears after x3 and repeats three of its pairs: the later values win
+    // (inequality rows are l1, then g1 and g2 negated)
+    auto expected = mps::parse_mps(mps_path.string());
+    ASSERT_EQ(expected->get_A_ineq().coeff(0, 0), -2.0);
+    ASSERT_EQ(expected->get_A_ineq().coeff(1, 0), -6.0);
+    ASSERT_EQ(expected->get_A_ineq().coeff(2, 0), -8.0);
+
+    mps::OutputOptions options;
+    options.row_group_size = 2;  // row groups written while parsing
+    auto [output_dir, total_time] = mps::stream_mps_to_parquet(mps_path.string(), "stream_instance",
+                                                               mps::ParseOptions(), options);
+    auto loaded = mps::load_lp_from_parquet(output_dir);
+
+    // The save time starts after the parse, so the two are not counted twice
+    std::ifstream metadata_file(fs::path(output_dir) / "metadata.json");
+    const auto metadata = nlohmann::json::parse(metadata_file);
+    ASSERT_LE(metadata.at("parse_time_seconds").get<double>() + metadata.at("save_parquet_time_seconds").get<double>(),
+              total_time);
+
+    ASSERT_EQ(loaded->get_n_vars(), expected->get_n_vars());
+    ASSERT_EQ(loaded->get_col_names(), expected->get_col_names());
+    ASSERT_EQ(loaded->get_c(), expected->get_c());
+    ASSERT_EQ(loaded->get_lb(), expected->get_lb());
+    ASSERT_EQ(loaded->get_ub(), expected->get_ub());
+    ASSERT_EQ(loaded->get_b_eq(), expected->get_b_eq());
+    ASSERT_EQ(loaded->get_b_ineq(), expected->get_b_ineq());
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_eq()), Eigen::MatrixXd(expected->get_A_eq()));
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(expected->get_A_ineq()));
+
+    options.format = mps::OutputFormat::Feather;
+    mps::stream_mps_to_parquet(mps_path.string(), "stream_instance", mps::ParseOptions(), options);
+    loaded = mps::load_lp_from_parquet(output_dir);
+    ASSERT_TRUE(fs::exists(fs::path(output_dir) / "A_ineq_coo.feather"));
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_eq()), Eigen::MatrixXd(expected->get_A_eq()));
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(expected->get_A_ineq()));
+
+    options.narrow_indices = true;
+    mps::stream_mps_to_parquet(mps_path.string(), "stream_instance", mps::ParseOptions(), options);
+    auto table = mps::read_table((fs::path(output_dir) / "A_ineq_coo.feather").string());
+    ASSERT_OK(table.status());
+    ASSERT_EQ((*table)->schema()->ToString(), "row: int32\ncol: int32\ndata: double");
+    loaded = mps::load_lp_from_parquet(output_dir);
+    ASSERT_EQ(Eigen::MatrixXd(loaded->get_A_ineq()), Eigen::MatrixXd(expected->get_A_ineq()));
+
+    options.matrix_layout = mps::MatrixLayout::Csc;
+    ASSERT_THROW(mps::stream_mps_to_parquet(mps_path.string(), "stream_instance", mps::ParseOptions(), options),
+                 std::invalid_argument);
+    options.matrix_layout = mps::MatrixLayout::Coo;
+
+    options.snapshot = true;
+    ASSERT_THROW(mps::stream_mps_to_parquet(mps_path.string(), "stream_instance", mps::ParseOptions(), options),
+                 std::invalid_argument);
+
+    fs::remove_all(output_dir);
+}
+
+TEST_F(ParquetWriterTest, LoadMissingDirectory) {
+    ASSERT_THROW(mps::load_lp_from_parquet((test_dir / "does_not_exist").string()), std::runtime_error);
+}
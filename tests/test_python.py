@@ -0,0 +1,116 @@
+"""Checks of the Python extension module built with -DMPS_BUILD_PYTHON=ON (run by ctest)."""
+import gc
+import os
+import tempfile
+import unittest
+from concurrent.futures import ThreadPoolExecutor
+
+import numpy as np
+import scipy.sparse
+
+import mps
+
+MPS_TEXT = """NAME          PYTEST
+ROWS
+ N  cost
+ L  lim
+ E  bal
+COLUMNS
+    x1        cost      1.5        lim       2
+    x1        bal       4
+    x2        cost      -1         lim       7.25
+    x3        bal       -0.5
+RHS
+    rhs       lim       10         bal       3
+BOUNDS
+ UP bnd       x1        4
+ENDATA
+"""
+
+
+def owner(array):
+    """Object at the end of an array's chain of bases (SciPy may add a view of its own)."""
+    while isinstance(array, np.ndarray) and array.base is not None:
+        array = array.base
+    return array
+
+
+def address(array):
+    return array.__array_interface__["data"][0]
+
+
+class ParseMpsTest(unittest.TestCase):
+    def setUp(self):
+        handle, self.path = tempfile.mkstemp(suffix=".mps")
+        with os.fdopen(handle, "w") as out:
+            out.write(MPS_TEXT)
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def test_fields(self):
+        lp = mps.parse_mps(self.path)
+        self.assertEqual(lp.n_vars, 3)
+        self.assertEqual(lp.col_names, ["x1", "x2", "x3"])
+        np.testing.assert_array_equal(lp.c, [1.5, -1.0, 0.0])
+        np.testing.assert_array_equal(lp.ub[0], 4.0)
+        np.testing.assert_array_equal(lp.b_eq, [3.0])
+        np.testing.assert_array_equal(lp.b_ineq, [10.0])
+        self.assertIsInstance(lp.A_eq, scipy.sparse.csc_matrix)
+        np.testing.assert_array_equal(lp.A_eq.toarray(), [[4.0, 0.0, -0.5]])
+        np.testing.assert_array_equal(lp.A_ineq.toarray(), [[2.0, 7.25, 0.0]])
+        self.assertIn("sections", lp.parse_stats)
+
+    def test_views_share_the_cpp_buffers(self):
+        lp = mps.parse_mps(self.path)
+        first, second = lp.A_eq, lp.A_eq
+        self.assertEqual(first.indices.dtype, np.int32)
+        for name in ("data", "indices", "indptr"):
+            # Owned by the LpData, and every access sees the same C++ buffer
+            self.assertIs(owner(getattr(first, name)), lp)
+            self.assertEqual(address(getattr(first, name)), address(getattr(second, name)))
+            self.assertFalse(getattr(first, name).flags.writeable)
+        self.assertIs(lp.c.base, lp)
+        self.assertEqual(address(lp.c), address(lp.c))
+        self.assertFalse(lp.c.flags.writeable)
+
+    def test_empty_blocks(self):
+        with open(self.path, "w") as out:
+            out.write("NAME EMPTY\nROWS\n N  cost\nCOLUMNS\n    x1        cost      1\nENDATA\n")
+        lp = mps.parse_mps(self.path)
+        self.assertEqual(lp.A_eq.shape, (0, 1))
+        self.assertEqual(lp.A_ineq.nnz, 0)
+        self.assertEqual(lp.b_eq.shape, (0,))
+
+    def test_views_keep_the_model_alive(self):
+        c = mps.parse_mps(self.path).c
+        A_ineq = mps.parse_mps(self.path).A_ineq
+        gc.collect()
+        np.testing.assert_array_equal(c, [1.5, -1.0, 0.0])
+        np.testing.assert_array_equal(A_ineq.toarray(), [[2.0, 7.25, 0.0]])
+
+    def test_parses_from_several_threads(self):
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            models = list(pool.map(lambda reader: mps.parse_mps(self.path, reader=reader), ["mmap", "stream"] * 4))
+        for lp in models:
+            np.testing.assert_array_equal(lp.A_eq.toarray(), models[0].A_eq.toarray())
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            mps.parse_mps(self.path, reader="mystery")
+        with self.assertRaises(RuntimeError):
+            mps.parse_mps(self.path + ".missing")
+        with self.assertRaises(RuntimeError):
+            mps.load_lp_from_parquet(self.path + ".missing")
+
+    def test_sample_file(self):
+        path = os.path.join(os.environ.get("MPS_FILES_DIR", "mps_files"), "50v-10.mps")
+        if not os.path.exists(path):
+            self.skipTest("50v-10.mps not found")
+        lp = mps.parse_mps(path, threads=0)
+        self.assertEqual(lp.A_ineq.shape, (len(lp.b_ineq), lp.n_vars))
+        self.assertEqual(lp.A_eq.nnz + lp.A_ineq.nnz, lp.A_eq.indptr[-1] + lp.A_ineq.indptr[-1])
+
+
+if __name__ == "__main__":
+    unittest.main()
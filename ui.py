@@ -32,7 +32,9 @@ def load_metadata(data_dir: Path) -> list[dict]:
                             metadata_list.append({
                                 "path": str(metadata_path),
                                 "parse_time_seconds": float(metadata["parse_time_seconds"]),
-                                "n_vars": int(metadata["n_vars"])
+                                "n_vars": int(metadata["n_vars"]),
+                                "parse_stats": metadata.get("parse_stats"),
+                                "save_files": metadata.get("save_files"),
                             })
                         else:
                             missing_keys = []
@@ -47,6 +49,24 @@ def load_metadata(data_dir: Path) -> list[dict]:
             #     st.warning(f"metadata.json not found in directory: {item}")
     return metadata_list
 
+def phase_seconds(item: dict) -> dict:
+    """Splits one instance's parse and save time into phases, from parse_stats and save_files."""
+    phases = {}
+    stats = item.get("parse_stats")
+    if stats:
+        for section in stats.get("sections", []):
+            key = f"read {section['name']}"
+            phases[key] = phases.get(key, 0.0) + section["seconds"]
+        phases["bounds"] = stats["bounds_seconds"]
+        phases["matrix assembly"] = stats["assembly_seconds"]
+        phases["build matrices (other)"] = stats["build_matrices_seconds"] - stats["assembly_seconds"]
+    for file_stats in (item.get("save_files") or {}).values():
+        phases["parquet encode"] = phases.get("parquet encode", 0.0) + file_stats["encode_seconds"]
+        phases["parquet write"] = phases.get("parquet write", 0.0) + file_stats["write_seconds"]
+        phases["arrow tables"] = phases.get("arrow tables", 0.0) + (
+            file_stats["seconds"] - file_stats["encode_seconds"] - file_stats["write_seconds"])
+    return phases
+
 # --- Streamlit App ---
 
 st.title("MPS File Parse Time Distribution")
@@ -94,3 +114,33 @@ if 'parse_times' in locals() and parse_times:
     st.write("Summary Statistics:")
     st.write(df.describe())
 
+# Per-phase breakdown, for the instances converted with instrumentation
+phase_rows = [
+    {"instance": Path(item["path"]).parent.name, "phase": phase, "seconds": seconds}
+    for item in all_metadata
+    for phase, seconds in phase_seconds(item).items()
+]
+if phase_rows:
+    phase_df = pd.DataFrame(phase_rows)
+    totals = phase_df.groupby("phase", as_index=False)["seconds"].sum().sort_values("seconds", ascending=False)
+    st.subheader("Where the time goes")
+    st.plotly_chart(
+        px.bar(totals, x="phase", y="seconds", title="Total time per phase across instances"),
+        use_container_width=True,
+    )
+
+    # Process-wide: a batch conversion's value covers every job that ran before it in the process
+    rss = [
+        {
+            "n_vars": item["n_vars"],
+            "Process peak RSS (MiB)": item["parse_stats"].get(
+                "process_peak_rss_bytes", item["parse_stats"].get("peak_rss_bytes", 0)
+            ) / 2**20,
+        }
+        for item in all_metadata if item.get("parse_stats")
+    ]
+    st.plotly_chart(
+        px.scatter(pd.DataFrame(rss), x="n_vars", y="Process peak RSS (MiB)",
+                   title="Process peak RSS after parsing (batch runs include earlier jobs)"),
+        use_container_width=True,
+    )